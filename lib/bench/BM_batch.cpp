@@ -0,0 +1,68 @@
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <ellcpp/batch_solve.hpp>
+#include <ellcpp/ell.hpp>
+#include <ellcpp/oracles/profit_oracle.hpp>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <xtensor/xarray.hpp>
+
+using Vec = xt::xarray<double, xt::layout_type::row_major>;
+using Job = std::tuple<profit_oracle, ell, double>;
+
+/*!
+ * @brief Profit scenarios with varying k
+ *
+ * @param[in] n number of jobs
+ * @return std::vector<Job>
+ */
+static auto make_jobs(size_t n) -> std::vector<Job>
+{
+    const auto p = 20.;
+    const auto A = 40.;
+    const auto a = Vec {0.1, 0.4};
+    const auto v = Vec {10., 35.};
+
+    auto jobs = std::vector<Job> {};
+    jobs.reserve(n);
+    for (auto i = 0U; i != n; ++i)
+    {
+        const auto k = 20. + 20. * double(i) / double(n);
+        jobs.emplace_back(
+            profit_oracle {p, A, k, a, v}, ell {100., Vec {0., 0.}}, 0.);
+    }
+    return jobs;
+}
+
+/*!
+ * @brief Throughput of cutting_plane_dc_batch() with state.range(0) workers
+ *
+ * @param[in,out] state
+ */
+static void BM_Profit_batch(benchmark::State& state)
+{
+    const auto n_jobs = 1000U;
+    auto pool = work_stealing_pool {size_t(state.range(0))};
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto jobs = make_jobs(n_jobs);
+        state.ResumeTiming();
+        auto num_iters = size_t {0};
+        cutting_plane_dc_batch(pool, jobs,
+            [&](size_t, const Vec&, double, const CInfo& info) {
+                num_iters += info.num_iters;
+            });
+        benchmark::DoNotOptimize(num_iters);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * n_jobs);
+}
+
+// Register the function as a benchmark
+BENCHMARK(BM_Profit_batch)
+    ->RangeMultiplier(2)
+    ->Range(1, std::max(1U, std::thread::hardware_concurrency()))
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
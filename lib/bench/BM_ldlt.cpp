@@ -0,0 +1,115 @@
+#include "benchmark/benchmark.h"
+#include <ellcpp/oracles/ldlt_ext.hpp>
+#include <xtensor/xarray.hpp>
+
+using Arr = xt::xarray<double, xt::layout_type::row_major>;
+
+/*!
+ * @brief Reference LDLT factorization (column access to T)
+ *
+ * @param[in,out] T
+ * @param[in] A
+ * @return the row where it stops (0 if A is positive definite)
+ */
+static auto naive_ldlt(Arr& T, const Arr& A) -> size_t
+{
+    const auto n = A.shape()[0];
+    for (auto i = 0U; i != n; ++i)
+    {
+        auto d = A(i, 0);
+        for (auto j = 0U; j != i; ++j)
+        {
+            T(j, i) = d;
+            T(i, j) = d / T(j, j);
+            auto s = j + 1;
+            d = A(i, s);
+            for (auto k = 0U; k != s; ++k)
+            {
+                d -= T(i, k) * T(k, s);
+            }
+        }
+        T(i, i) = d;
+        if (d <= 0.)
+        {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+/*!
+ * @brief A positive definite matrix of size m (fully factored)
+ *
+ * @param[in] m
+ * @return Arr
+ */
+static auto spd_matrix(size_t m) -> Arr
+{
+    auto A = Arr {xt::zeros<double>({m, m})};
+    for (auto i = 0U; i != m; ++i)
+    {
+        for (auto j = 0U; j != m; ++j)
+        {
+            A(i, j) = 1. / (1. + double(i > j ? i - j : j - i));
+        }
+        A(i, i) += double(m);
+    }
+    return A;
+}
+
+/*!
+ * @brief
+ *
+ * @param[in,out] state
+ */
+static void BM_ldlt_naive(benchmark::State& state)
+{
+    const auto m = size_t(state.range(0));
+    const auto A = spd_matrix(m);
+    auto T = Arr {xt::zeros<double>({m, m})};
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(naive_ldlt(T, A));
+    }
+}
+BENCHMARK(BM_ldlt_naive)->RangeMultiplier(10)->Range(10, 1000);
+
+/*!
+ * @brief
+ *
+ * @param[in,out] state
+ */
+static void BM_ldlt_ext(benchmark::State& state)
+{
+    const auto m = size_t(state.range(0));
+    const auto A = spd_matrix(m);
+    auto Q = ldlt_ext(m);
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(Q.factorize(A));
+    }
+}
+BENCHMARK(BM_ldlt_ext)->RangeMultiplier(10)->Range(10, 1000);
+
+/*!
+ * @brief
+ *
+ * @param[in,out] state
+ */
+static void BM_ldlt_ext_mixed(benchmark::State& state)
+{
+    const auto m = size_t(state.range(0));
+    const auto A = spd_matrix(m);
+    auto Q = ldlt_ext(m);
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(
+            Q.factor_mixed([&](size_t i, size_t j) { return A(i, j); }));
+    }
+}
+BENCHMARK(BM_ldlt_ext_mixed)->RangeMultiplier(10)->Range(10, 1000);
+
+BENCHMARK_MAIN();
@@ -1,11 +1,22 @@
 #include "benchmark/benchmark.h"
+#include <ellcpp/accpm.hpp>
 #include <ellcpp/cutting_plane.hpp>
 #include <ellcpp/ell.hpp>
+#include <ellcpp/oracles/chordal_lmi_oracle.hpp>
+#include <ellcpp/oracles/composite_oracle.hpp>
+#include <ellcpp/oracles/lanczos_lmi_oracle.hpp>
 #include <ellcpp/oracles/lmi_old_oracle.hpp>
 #include <ellcpp/oracles/lmi_oracle.hpp>
+#include <ellcpp/oracles/low_rank_matrices.hpp>
+#include <ellcpp/oracles/sparse_lmi_oracle.hpp>
+#include <ellcpp/oracles/stacked_matrices.hpp>
 #include <gsl/span>
 #include <vector>
 #include <xtensor-blas/xlinalg.hpp>
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xmanipulation.hpp>
+#include <xtensor/xrandom.hpp>
+#include <xtensor/xview.hpp>
 
 
 /*!
@@ -47,7 +58,7 @@ class my_oracle
      *
      * @param[in] x
      * @param[in] t
-     * @return std::tuple<Cut, double>
+     * @return std::tuple<Cut, bool>
      */
     std::tuple<Cut, bool> operator()(const Arr& x, double& t)
     {
@@ -97,12 +108,129 @@ static void BM_LMI_Lazy(benchmark::State& state)
         auto E = ell(10., Arr {0., 0., 0.});
         auto t = 1.e100; // std::numeric_limits<double>::max()
         [[maybe_unused]] const auto rslt = cutting_plane_dc(P, E, t);
+        state.counters["oracle_calls"] = double(std::get<1>(rslt).num_iters);
     }
 }
 
 // Register the function as a benchmark
 BENCHMARK(BM_LMI_Lazy);
 
+/*!
+ * @brief Same problem, analytic-center cutting-plane instead of ellipsoid
+ *
+ * @param[in,out] state
+ */
+static void BM_LMI_accpm(benchmark::State& state)
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+
+    const auto F1 = std::vector<Arr> {{{-7., -11.}, {-11., 3.}},
+        {{7., -18.}, {-18., 8.}}, {{-2., -8.}, {-8., 1.}}};
+    const auto B1 = Arr {{33., -9.}, {-9., 26.}};
+    const auto F2 =
+        std::vector<Arr> {{{-21., -11., 0.}, {-11., 10., 8.}, {0., 8., 5.}},
+            {{0., 10., 16.}, {10., -10., -10.}, {16., -10., 3.}},
+            {{-5., 2., -17.}, {2., -6., 8.}, {-17., 8., 6.}}};
+    const auto B2 = Arr {{14., 9., 40.}, {9., 91., 10.}, {40., 10., 15.}};
+
+    while (state.KeepRunning())
+    {
+        auto P = my_oracle<lmi_oracle>(F1, B1, F2, B2, Arr {1., -1., 1.});
+        auto S = accpm(10., Arr {0., 0., 0.});
+        auto t = 1.e100; // std::numeric_limits<double>::max()
+        [[maybe_unused]] const auto rslt = cutting_plane_dc(P, S, t);
+        state.counters["oracle_calls"] = double(std::get<1>(rslt).num_iters);
+    }
+}
+BENCHMARK(BM_LMI_accpm);
+
+/*!
+ * @brief Same as my_oracle, with the LMIs checked by a composite_oracle
+ */
+class my_composite_oracle
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+    using Cut = std::tuple<Arr, double>;
+
+  private:
+    composite_oracle<lmi_oracle, lmi_oracle> lmis;
+    const Arr c;
+
+  public:
+    /*!
+     * @brief Construct a new my composite oracle object
+     *
+     * @param[in] F1
+     * @param[in] B1
+     * @param[in] F2
+     * @param[in] B2
+     * @param[in] c
+     * @param[in] deterministic
+     */
+    my_composite_oracle(gsl::span<const Arr> F1, const Arr& B1,
+        gsl::span<const Arr> F2, const Arr& B2, Arr c, bool deterministic)
+        : lmis {lmi_oracle {F1, B1}, lmi_oracle {F2, B2}}
+        , c {std::move(c)}
+    {
+        this->lmis.deterministic = deterministic;
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] x
+     * @param[in] t
+     * @return std::tuple<Cut, bool>
+     */
+    std::tuple<Cut, bool> operator()(const Arr& x, double& t)
+    {
+        const auto f0 = xt::linalg::dot(this->c, x)();
+        const auto f1 = f0 - t;
+        if (f1 > 0)
+        {
+            return {{this->c, f1}, false};
+        }
+        if (auto cut = this->lmis(x))
+        {
+            return {std::move(*cut), false};
+        }
+        t = f0;
+        return {{this->c, 0.}, true};
+    }
+};
+
+/*!
+ * @brief Same problem, LMIs reordered adaptively
+ *
+ *    state.range(0): deterministic mode
+ *
+ * @param[in,out] state
+ */
+static void BM_LMI_composite(benchmark::State& state)
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+
+    const auto F1 = std::vector<Arr> {{{-7., -11.}, {-11., 3.}},
+        {{7., -18.}, {-18., 8.}}, {{-2., -8.}, {-8., 1.}}};
+    const auto B1 = Arr {{33., -9.}, {-9., 26.}};
+    const auto F2 =
+        std::vector<Arr> {{{-21., -11., 0.}, {-11., 10., 8.}, {0., 8., 5.}},
+            {{0., 10., 16.}, {10., -10., -10.}, {16., -10., 3.}},
+            {{-5., 2., -17.}, {2., -6., 8.}, {-17., 8., 6.}}};
+    const auto B2 = Arr {{14., 9., 40.}, {9., 91., 10.}, {40., 10., 15.}};
+
+    while (state.KeepRunning())
+    {
+        auto P = my_composite_oracle(
+            F1, B1, F2, B2, Arr {1., -1., 1.}, state.range(0) != 0);
+        auto E = ell(10., Arr {0., 0., 0.});
+        auto t = 1.e100; // std::numeric_limits<double>::max()
+        [[maybe_unused]] const auto rslt = cutting_plane_dc(P, E, t);
+        state.counters["oracle_calls"] = double(std::get<1>(rslt).num_iters);
+    }
+}
+BENCHMARK(BM_LMI_composite)->Arg(0)->Arg(1);
+
 //~~~~~~~~~~~~~~~~
 
 /*!
@@ -166,6 +294,360 @@ static void BM_LMI_No_Trick(benchmark::State& state)
 // Register the function as a benchmark
 BENCHMARK(BM_LMI_No_Trick);
 
+/*!
+ * @brief Assess 64 points, one by one (arg 0) or as a batch (arg 1)
+ *
+ * @param[in,out] state
+ */
+static void BM_LMI_batch(benchmark::State& state)
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+
+    const auto F2 =
+        std::vector<Arr> {{{-21., -11., 0.}, {-11., 10., 8.}, {0., 8., 5.}},
+            {{0., 10., 16.}, {10., -10., -10.}, {16., -10., 3.}},
+            {{-5., 2., -17.}, {2., -6., 8.}, {-17., 8., 6.}}};
+    const auto B2 = Arr {{14., 9., 40.}, {9., 91., 10.}, {40., 10., 15.}};
+    const auto X = Arr {xt::random::rand<double>({64U, 3U}) - 0.5};
+    auto P = lmi_oracle {F2, B2};
+
+    while (state.KeepRunning())
+    {
+        if (state.range(0) == 0)
+        {
+            for (auto p = 0U; p != X.shape()[0]; ++p)
+            {
+                benchmark::DoNotOptimize(
+                    P(Arr {xt::view(X, p, xt::all())}));
+            }
+        }
+        else
+        {
+            benchmark::DoNotOptimize(P.evaluate_batch(X));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * int64_t(X.shape()[0]));
+}
+BENCHMARK(BM_LMI_batch)->Arg(0)->Arg(1);
+
+using Arr = xt::xarray<double, xt::layout_type::row_major>;
+
+/*!
+ * @brief F_k for the assembly benchmarks: m x m, symmetric, small
+ */
+static auto assembly_data(size_t m, size_t n) -> std::vector<Arr>
+{
+    auto F = std::vector<Arr> {};
+    for (auto k = 0U; k != n; ++k)
+    {
+        auto Fk = Arr {xt::random::rand<double>({m, m}) - 0.5};
+        F.emplace_back(Arr {(Fk + xt::transpose(Fk)) / double(n)});
+    }
+    return F;
+}
+
+/*!
+ * @brief Assess a feasible point of an m x m LMI with n variables, the
+ *        entries of A being gathered across the n matrices F_k
+ *
+ * @param[in,out] state
+ */
+static void BM_LMI_assembly_gather(benchmark::State& state)
+{
+    constexpr auto m = 40U;
+    const auto n = size_t(state.range(0));
+    const auto F = assembly_data(m, n);
+    const auto B = Arr {double(m) * xt::eye(m)};
+    const auto x = Arr {xt::ones<double>({n})};
+    auto Q = ldlt_ext {m};
+
+    while (state.KeepRunning())
+    {
+        auto getA = [&](size_t i, size_t j) -> double {
+            auto a = B(i, j);
+            for (auto k = 0U; k != n; ++k)
+            {
+                a -= F[k](i, j) * x(k);
+            }
+            return a;
+        };
+        benchmark::DoNotOptimize(Q.factor(getA));
+    }
+}
+BENCHMARK(BM_LMI_assembly_gather)->Arg(10)->Arg(40)->Arg(160);
+
+/*!
+ * @brief Same as above, with the compiled layout of lmi_oracle
+ *
+ * @param[in,out] state
+ */
+static void BM_LMI_assembly_compiled(benchmark::State& state)
+{
+    constexpr auto m = 40U;
+    const auto n = size_t(state.range(0));
+    const auto F = assembly_data(m, n);
+    const auto B = Arr {double(m) * xt::eye(m)};
+    const auto x = Arr {xt::ones<double>({n})};
+    auto P = lmi_oracle {F, B};
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(P(x));
+    }
+}
+BENCHMARK(BM_LMI_assembly_compiled)->Arg(10)->Arg(40)->Arg(160);
+
+/*!
+ * @brief Gradient of an LMI cut with a witness of m rows: one sym_quad()
+ *        per F_k (arg 0) or the packed engine (arg 1)
+ *
+ * @param[in,out] state
+ */
+static void BM_LMI_gradient(benchmark::State& state)
+{
+    constexpr auto m = 100U;
+    constexpr auto n = 400U;
+    const auto F = assembly_data(m, n);
+    const auto Fc = detail::pack_lower(F);
+    auto A = Arr {xt::eye(m)};
+    A(m - 1, m - 1) = -1.;
+    auto Q = ldlt_ext {m};
+    Q.factorize(A);
+    Q.witness();
+    auto g = Arr {xt::zeros<double>({n})};
+
+    while (state.KeepRunning())
+    {
+        if (state.range(0) == 0)
+        {
+            for (auto k = 0U; k != n; ++k)
+            {
+                g(k) = Q.sym_quad(F[k]);
+            }
+        }
+        else
+        {
+            detail::packed_sym_quad(Fc, Q.v, Q.p, 1., g);
+        }
+        benchmark::DoNotOptimize(g.data());
+    }
+}
+BENCHMARK(BM_LMI_gradient)->Arg(0)->Arg(1)->UseRealTime();
+
+/*!
+ * @brief Assess a point of an m x m LMI where each F_k couples two
+ *        neighbouring rows: dense (arg 0) or sparse (arg 1) oracle
+ *
+ * @param[in,out] state
+ */
+static void BM_LMI_sparse(benchmark::State& state)
+{
+    constexpr auto m = 200U;
+    constexpr auto n = m - 1;
+    auto F = std::vector<Arr> {};
+    auto Fs = std::vector<coo_matrix> {};
+    for (auto k = 0U; k != n; ++k)
+    {
+        auto& Fk = F.emplace_back(Arr {xt::zeros<double>({m, m})});
+        Fk(k, k) = Fk(k + 1, k + 1) = 1.;
+        Fk(k + 1, k) = Fk(k, k + 1) = -1.;
+        Fs.push_back({{k, k + 1, k + 1}, {k, k, k + 1}, {1., -1., 1.}});
+    }
+    const auto B = Arr {double(m) * xt::eye(m)};
+    const auto x = Arr {xt::ones<double>({n})};
+    auto P0 = lmi_oracle {F, B};
+    auto P1 = sparse_lmi_oracle {Fs, B};
+
+    while (state.KeepRunning())
+    {
+        if (state.range(0) == 0)
+        {
+            benchmark::DoNotOptimize(P0(x));
+        }
+        else
+        {
+            benchmark::DoNotOptimize(P1(x));
+        }
+    }
+}
+BENCHMARK(BM_LMI_sparse)->Arg(0)->Arg(1);
+
+/*!
+ * @brief Assess a feasible point of a block-diagonal LMI (blocks of 20
+ *        rows): sparse (arg 0) or chordal (arg 1) oracle
+ *
+ * @param[in,out] state
+ */
+static void BM_LMI_chordal(benchmark::State& state)
+{
+    constexpr auto m = 400U;
+    constexpr auto nb = 20U; // rows per block
+    auto B = coo_matrix {};
+    auto F = std::vector<coo_matrix>(m / nb);
+    for (auto i = 0U; i != m; ++i)
+    {
+        B.row.push_back(i);
+        B.col.push_back(i);
+        B.val.push_back(double(nb));
+        for (auto j = i - i % nb; j != i; ++j)
+        {
+            B.row.push_back(i);
+            B.col.push_back(j);
+            B.val.push_back(0.5);
+            F[i / nb].row.push_back(i);
+            F[i / nb].col.push_back(j);
+            F[i / nb].val.push_back(0.1);
+        }
+    }
+    const auto Bd = [&] {
+        auto res = Arr {xt::zeros<double>({m, m})};
+        for (auto t = 0U; t != B.val.size(); ++t)
+        {
+            res(B.row[t], B.col[t]) = res(B.col[t], B.row[t]) = B.val[t];
+        }
+        return res;
+    }();
+    const auto x = Arr {xt::ones<double>({m / nb})};
+    auto P0 = sparse_lmi_oracle {F, Bd};
+    auto P1 = chordal_lmi_oracle {m, F, B};
+
+    while (state.KeepRunning())
+    {
+        if (state.range(0) == 0)
+        {
+            benchmark::DoNotOptimize(P0(x));
+        }
+        else
+        {
+            benchmark::DoNotOptimize(P1(x));
+        }
+    }
+}
+BENCHMARK(BM_LMI_chordal)->Arg(0)->Arg(1)->UseRealTime();
+
+/*!
+ * @brief Assess an infeasible point of an LMI with rank-one F_k = u_k u_k',
+ *        violated near the last row: given densely (arg 0) or in low-rank
+ *        form (arg 1)
+ *
+ * @param[in,out] state
+ */
+static void BM_LMI_low_rank(benchmark::State& state)
+{
+    constexpr auto m = 200U;
+    constexpr auto n = 20U;
+    auto F = std::vector<Arr> {};
+    auto L = std::vector<low_rank_matrix> {};
+    for (auto k = 0U; k != n; ++k)
+    {
+        const auto u = Arr {xt::random::rand<double>({m, 1U}) - 0.5};
+        F.emplace_back(xt::linalg::dot(u, xt::transpose(u)));
+        L.push_back({u, u});
+    }
+    auto B = Arr {10. * xt::eye(m)};
+    B(m - 1, m - 1) = 0.;
+    const auto x = Arr {xt::ones<double>({n})};
+    auto P0 = lmi_oracle {F, B};
+    auto P1 = lmi_oracle {gsl::span<const Arr> {}, L, B};
+
+    while (state.KeepRunning())
+    {
+        if (state.range(0) == 0)
+        {
+            benchmark::DoNotOptimize(P0(x));
+        }
+        else
+        {
+            benchmark::DoNotOptimize(P1(x));
+        }
+    }
+}
+BENCHMARK(BM_LMI_low_rank)->Arg(0)->Arg(1);
+
+/*!
+ * @brief Assess repeatedly a point violated at the last row: natural
+ *        (arg 0) or adaptive (arg 1) pivot order
+ *
+ * @param[in,out] state
+ */
+static void BM_LMI_adaptive_pivoting(benchmark::State& state)
+{
+    constexpr auto m = 100U;
+    constexpr auto n = 40U;
+    const auto F = assembly_data(m, n);
+    auto B = Arr {xt::eye(m)};
+    B(m - 1, m - 1) = -1.;
+    const auto x = Arr {0.1 * xt::ones<double>({n})};
+    auto P = lmi_oracle {F, B};
+    P.set_adaptive_pivoting(state.range(0) == 1);
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(P(x));
+    }
+}
+BENCHMARK(BM_LMI_adaptive_pivoting)->Arg(0)->Arg(1);
+
+/*!
+ * @brief Assess a point of a tridiagonal LMI with the LDLT (arg 0),
+ *        Lanczos (arg 1) or uncertified Lanczos (arg 2) oracle; the point
+ *        is violated at the last row (second arg 0) or feasible (1)
+ *
+ *    At a feasible point, the Lanczos oracle still factors A to certify
+ *    it, so that it costs about as much as the LDLT one; only the
+ *    uncertified one is cheaper there (see set_certification()).
+ *
+ * @param[in,out] state
+ */
+static void BM_LMI_lanczos(benchmark::State& state)
+{
+    constexpr auto m = 300U;
+    auto B = coo_matrix {};
+    auto I = coo_matrix {};
+    for (auto i = 0U; i != m; ++i)
+    {
+        B.row.push_back(i);
+        B.col.push_back(i);
+        B.val.push_back(i + 1 == m ? 0.5 : 3.);
+        I.row.push_back(i);
+        I.col.push_back(i);
+        I.val.push_back(1.);
+        if (i + 1 != m)
+        {
+            B.row.push_back(i + 1);
+            B.col.push_back(i);
+            B.val.push_back(-1.);
+        }
+    }
+    auto Bd = Arr {xt::zeros<double>({m, m})};
+    for (auto t = 0U; t != B.val.size(); ++t)
+    {
+        Bd(B.row[t], B.col[t]) = Bd(B.col[t], B.row[t]) = B.val[t];
+    }
+    const auto x = Arr {state.range(1) == 0 ? 0.5 : -1.};
+    auto P0 = sparse_lmi_oracle {{I}, Bd};
+    auto P1 = lanczos_lmi_oracle {m, {I}, B};
+    P1.set_certification(state.range(0) == 1);
+
+    while (state.KeepRunning())
+    {
+        if (state.range(0) == 0)
+        {
+            benchmark::DoNotOptimize(P0(x));
+        }
+        else
+        {
+            benchmark::DoNotOptimize(P1(x));
+        }
+    }
+}
+BENCHMARK(BM_LMI_lanczos)
+    ->Args({0, 0})
+    ->Args({1, 0})
+    ->Args({0, 1})
+    ->Args({1, 1})
+    ->Args({2, 1});
+
 BENCHMARK_MAIN();
 
 /*
@@ -175,4 +657,10 @@ Benchmark                Time             CPU   Iterations
 BM_LMI_Lazy         131235 ns       131245 ns         4447
 BM_LMI_old          196694 ns       196708 ns         3548
 BM_LMI_No_Trick     129743 ns       129750 ns         5357
+
+BM_LMI_lanczos/0/0    2997680 ns      2959155 ns          237
+BM_LMI_lanczos/1/0      12648 ns        11992 ns        52265
+BM_LMI_lanczos/0/1    2927095 ns      2784222 ns          325
+BM_LMI_lanczos/1/1    2471491 ns      2428787 ns          242
+BM_LMI_lanczos/2/1       6611 ns         6574 ns       117748
 */
\ No newline at end of file
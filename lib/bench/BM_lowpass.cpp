@@ -5,6 +5,7 @@
 
 #include <cmath>
 #include <complex>
+#include <ellcpp/accpm.hpp>
 #include <ellcpp/cutting_plane.hpp>
 #include <ellcpp/ell.hpp>
 #include <ellcpp/oracles/lowpass_oracle.hpp>
@@ -101,10 +102,11 @@ static const auto Spsq = Sp * Sp;
 // optimization
 // ********************************************************************
 
+template <typename Space = ell>
 static auto run_lowpass(bool use_parallel_cut)
 {
     auto r0 = zeros({N}); // initial x0
-    auto E = ell(40., r0);
+    auto E = Space(40., r0);
     auto P = lowpass_oracle(Ap, As, Anr, Lpsq, Upsq);
     const auto options = Options {50000, 1e-8};
 
@@ -117,7 +119,7 @@ static auto run_lowpass(bool use_parallel_cut)
     // std::cout << "lowpass r: " << r << '\n';
     // auto Ustop = 20 * std::log10(std::sqrt(Spsq_new));
     // std::cout << "Min attenuation in the stopband is " << Ustop << " dB.\n";
-    return std::make_tuple(ell_info.feasible, ell_info.num_iters);
+    return std::make_tuple(ell_info.feasible, ell_info.num_iters, t);
 }
 
 static void BM_Lowpass_single_cut(benchmark::State& state)
@@ -132,13 +134,26 @@ static void BM_Lowpass_parallel_cut(benchmark::State& state)
 {
     while (state.KeepRunning())
     {
-        run_lowpass(true);
+        const auto [feasible, num_iters, Spsq_new] = run_lowpass(true);
+        state.counters["oracle_calls"] = double(num_iters);
+        state.counters["Spsq"] = Spsq_new;
+    }
+}
+
+static void BM_Lowpass_accpm(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        const auto [feasible, num_iters, Spsq_new] = run_lowpass<accpm>(true);
+        state.counters["oracle_calls"] = double(num_iters);
+        state.counters["Spsq"] = Spsq_new;
     }
 }
 
 // Register the function as a benchmark
 BENCHMARK(BM_Lowpass_single_cut);
 BENCHMARK(BM_Lowpass_parallel_cut);
+BENCHMARK(BM_Lowpass_accpm);
 
 BENCHMARK_MAIN();
 
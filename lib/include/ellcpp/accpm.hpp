@@ -0,0 +1,189 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <vector>
+#include <xtensor/xarray.hpp>
+
+// forward declaration
+enum class CUTStatus;
+
+/*!
+ * @brief Analytic-center cutting-plane (ACCPM) Search Space
+ *
+ *        P = {x | lb \le x \le ub,  a_i' x \le b_i, i = 1..m}
+ *
+ * Keep the polyhedron of the accumulated cuts and report its
+ * (approximate) analytic center, i.e. the minimizer of the barrier
+ *
+ *        phi(x) = -\sum log(b_i - a_i' x) - \sum log(ub - x) - \sum log(x - lb)
+ *
+ * After each cut, the center is backed off along the Dikin direction
+ * -H^-1 g into the new polyhedron and re-centered by damped Newton steps.
+ * Redundant cuts are dropped; the initial box is always kept.
+ *
+ * Follows the same contract as `ell` (xc(), set_xc(), copy(), update()),
+ * so cutting_plane_dc() and friends run unchanged.
+ */
+class accpm
+{
+  public:
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+
+    bool use_parallel_cut = true;
+    size_t max_cuts;                 //!< keep at most this many cuts (4 n)
+    unsigned int newton_max_it = 50; //!< Newton steps per re-centering
+    double newton_tol = 1e-10;       //!< on the squared Newton decrement
+
+  private:
+    const size_t _n;
+    Arr _lb;
+    Arr _ub;
+    std::vector<Arr> _A;
+    std::vector<double> _b;
+    Arr _xc;
+    Arr _H; //!< Hessian of the barrier at xc
+
+    auto operator=(const accpm& S) -> accpm& = delete;
+
+  public:
+    /*!
+     * @brief Construct a new accpm object
+     *
+     *        initial box: |x_i - x0_i| \le sqrt(val_i)
+     *
+     * @param[in] val
+     * @param[in] x
+     */
+    accpm(const Arr& val, Arr x);
+
+    /*!
+     * @brief Construct a new accpm object
+     *
+     *        initial box: |x_i - x0_i| \le sqrt(alpha)
+     *
+     * @param[in] alpha
+     * @param[in] x
+     */
+    accpm(const double& alpha, Arr x);
+
+    /**
+     * @brief Construct a new accpm object
+     *
+     * @param[in] S (move)
+     */
+    accpm(accpm&& S) = default;
+
+    /**
+     * @brief Construct a new accpm object
+     *
+     * To avoid accidentally copying, only explicit copy is allowed
+     *
+     * @param S
+     */
+    explicit accpm(const accpm& S) = default;
+
+    /**
+     * @brief explicitly copy
+     *
+     * @return accpm
+     */
+    [[nodiscard]] auto copy() const -> accpm
+    {
+        return accpm(*this);
+    }
+
+    /*!
+     * @brief copy the whole array anyway
+     *
+     * @return Arr
+     */
+    [[nodiscard]] auto xc() const -> Arr
+    {
+        return this->_xc;
+    }
+
+    /*!
+     * @brief Set the xc object
+     *
+     * xc must be strictly inside the polyhedron.
+     *
+     * @param[in] xc
+     */
+    void set_xc(const Arr& xc);
+
+    /*!
+     * @brief Number of cuts currently kept (box excluded)
+     *
+     * @return size_t
+     */
+    [[nodiscard]] auto num_cuts() const noexcept -> size_t
+    {
+        return this->_b.size();
+    }
+
+    /*!
+     * @brief Add the cut(s) and move to the new analytic center
+     *
+     *        g' (x - xc) + beta0 \le 0
+     *        g' (x - xc) + beta1 \ge 0  (parallel cut)
+     *
+     * The returned tsq = M^2 g' H^-1 g, with M the number of constraints,
+     * bounds (g' (x - xc))^2 over the polyhedron (Dikin ellipsoid
+     * scaled by M around the analytic center), so it plays the same role
+     * as in `ell`.
+     *
+     * The status is nosoln only if the cut leaves nothing of the
+     * polyhedron. It is noeffect if the cut is inactive, or if the new
+     * center is not reached within newton_max_it steps; the polyhedron is
+     * then left unchanged.
+     *
+     * @tparam T
+     * @param[in] cut cutting-plane
+     * @return std::tuple<CUTStatus, double>
+     */
+    template <typename T>
+    auto update(const std::tuple<Arr, T>& cut) -> std::tuple<CUTStatus, double>;
+
+  private:
+    /*!
+     * @brief Gradient and Hessian of the barrier at x
+     *
+     * @param[in] x
+     * @param[out] grad
+     * @param[out] H
+     */
+    void _derivatives(const Arr& x, Arr& grad, Arr& H) const;
+
+    /*!
+     * @brief Largest step s such that x + s d stays strictly inside
+     *
+     * @param[in] x
+     * @param[in] d
+     * @return double
+     */
+    [[nodiscard]] auto _max_step(const Arr& x, const Arr& d) const -> double;
+
+    /*!
+     * @brief Warm start: walk from x into the slab lo < g' x < hi
+     *
+     * @param[in,out] x
+     * @param[in] g
+     * @param[in] lo
+     * @param[in] hi
+     * @return false if the slab is not reached
+     */
+    auto _enter(Arr& x, const Arr& g, double lo, double hi) const -> bool;
+
+    /*!
+     * @brief Re-center by damped Newton steps, starting from xc
+     */
+    void _center();
+
+    /*!
+     * @brief Drop redundant cuts, then the least relevant ones
+     *        beyond max_cuts
+     */
+    void _prune();
+}; // } accpm
@@ -0,0 +1,70 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include "cutting_plane.hpp"
+#include "work_stealing_pool.hpp"
+#include <iterator>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+/*!
+ * @brief Solve many independent problems with cutting_plane_dc()
+ *
+ *    Each job is a std::tuple<Oracle, Space, opt_type> and is solved in
+ *    place on one worker of the pool: when it finishes, the job's space
+ *    and t hold the final ellipsoid and the best value. The results are
+ *    streamed back through `on_done(i, x_best, t, info)` as each job
+ *    finishes (in completion order, not in job order). The calls are
+ *    serialized, so `on_done` needs no locking of its own.
+ *
+ *    Oracles that need scratch storage per worker can index it with
+ *    `pool.worker_index()`.
+ *
+ * @tparam Jobs random access range of std::tuple<Oracle, Space, opt_type>
+ * @tparam Fn
+ * @param[in]     pool    dedicated pool; waits until it is idle
+ * @param[in,out] jobs
+ * @param[in]     on_done callback: on_done(i, x_best, t, info)
+ * @param[in]     options maximum iteration and tolerance
+ */
+template <typename Jobs, typename Fn>
+void cutting_plane_dc_batch(work_stealing_pool& pool, Jobs& jobs, Fn&& on_done,
+    const Options& options = Options())
+{
+    std::mutex mtx;
+    const auto n = std::size(jobs);
+    for (auto i = decltype(n) {0}; i != n; ++i)
+    {
+        pool.submit([&, i] {
+            auto& job = jobs[i];
+            auto& t = std::get<2>(job);
+            auto [x_best, info] = cutting_plane_dc(
+                std::get<0>(job), std::get<1>(job), t, options);
+            std::lock_guard<std::mutex> lock(mtx);
+            on_done(i, std::move(x_best), t, info);
+        });
+    }
+    pool.wait_idle();
+}
+
+/*!
+ * @brief Solve many independent problems with cutting_plane_dc()
+ *
+ *    Same as above, with a pool of `n_workers` threads created for the
+ *    batch.
+ *
+ * @tparam Jobs random access range of std::tuple<Oracle, Space, opt_type>
+ * @tparam Fn
+ * @param[in,out] jobs
+ * @param[in]     on_done   callback: on_done(i, x_best, t, info)
+ * @param[in]     n_workers number of worker threads
+ * @param[in]     options   maximum iteration and tolerance
+ */
+template <typename Jobs, typename Fn>
+void cutting_plane_dc_batch(Jobs& jobs, Fn&& on_done, size_t n_workers,
+    const Options& options = Options())
+{
+    auto pool = work_stealing_pool {n_workers};
+    cutting_plane_dc_batch(pool, jobs, std::forward<Fn>(on_done), options);
+}
@@ -0,0 +1,276 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include "cutting_plane.hpp"
+#include "work_stealing_pool.hpp"
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <xtensor/xbuilder.hpp>
+
+namespace detail
+{
+
+/*!
+ * @brief Oracle of a branch-and-bound node
+ *
+ *    Enforces the branching bounds lb \le x \le ub of the node before
+ *    asking the oracle of the problem.
+ *
+ * @tparam Oracle
+ * @tparam Arr
+ */
+template <typename Oracle, typename Arr>
+class node_oracle
+{
+    using Cut = std::tuple<Arr, double>;
+
+  private:
+    Oracle& _Omega;
+    const Arr& _lb;
+    const Arr& _ub;
+
+  public:
+    /*!
+     * @brief Construct a new node oracle object
+     *
+     * @param[in] Omega oracle of the problem
+     * @param[in] lb
+     * @param[in] ub
+     */
+    node_oracle(Oracle& Omega, const Arr& lb, const Arr& ub)
+        : _Omega {Omega}
+        , _lb {lb}
+        , _ub {ub}
+    {
+    }
+
+    /*!
+     * @brief Make object callable for cutting_plane_dc()
+     *
+     * @param[in] x
+     * @param[in,out] t the best-so-far optimal value
+     * @return std::tuple<Cut, bool>
+     */
+    auto operator()(const Arr& x, double& t) -> std::tuple<Cut, bool>
+    {
+        for (auto i = 0U; i != x.size(); ++i)
+        {
+            if (x(i) > this->_ub(i))
+            {
+                auto g = Arr {xt::zeros_like(x)};
+                g(i) = 1.;
+                return {{std::move(g), x(i) - this->_ub(i)}, false};
+            }
+            if (x(i) < this->_lb(i))
+            {
+                auto g = Arr {xt::zeros_like(x)};
+                g(i) = -1.;
+                return {{std::move(g), this->_lb(i) - x(i)}, false};
+            }
+        }
+        return this->_Omega(x, t);
+    }
+};
+
+} // namespace detail
+
+/*!
+ * @brief Parallel branch and bound for mixed-integer convex problems
+ *
+ *        min  f(x)
+ *        s.t. x_i integer, for all i with integer[i]
+ *
+ *    The relaxation of each node is solved by cutting_plane_dc(), with the
+ *    best-so-far value as the starting t, so a node that cannot beat the
+ *    incumbent is pruned as soon as it is solved. Its solution is rounded
+ *    to give a candidate for the incumbent, and the node is split on its
+ *    most fractional variable: x_i \le floor(v) or x_i \ge ceil(v).
+ *
+ *    A child starts from a copy of its parent's initial search space cut
+ *    by the branching constraint, which still contains the child's part
+ *    of the feasible set (warm start).
+ *
+ *    Nodes are tasks of the work-stealing pool: each worker dives
+ *    depth-first into its own subtree, while idle workers steal the
+ *    oldest (shallowest) open nodes. The incumbent value is read without
+ *    locking; improving it takes a lock.
+ *
+ *    The oracle factory is called once per node, so that nodes do not
+ *    share oracle state.
+ *
+ * @tparam Factory
+ * @tparam Space
+ * @param[in]     pool        dedicated pool; waits until it is idle
+ * @param[in]     make_oracle returns a fresh oracle for cutting_plane_dc()
+ * @param[in]     S           search Space containing x*
+ * @param[in]     integer     which variables must be integral
+ * @param[in,out] t           best-so-far optimal value
+ * @param[in]     options     for the relaxations; the deadline and the
+ *                            cancellation flag also stop the search
+ * @return x_best and Information (num_iters: number of nodes solved)
+ * @throw std::invalid_argument if integer does not have one entry per
+ *        variable
+ */
+template <typename Factory, typename Space>
+auto branch_bound(work_stealing_pool& pool, Factory&& make_oracle,
+    const Space& S, const std::vector<bool>& integer, double& t,
+    const Options& options = Options())
+{
+    using Arr = decltype(S.xc());
+    using Oracle = decltype(make_oracle());
+    constexpr auto int_tol = 1e-6; // integrality tolerance
+
+    struct Node
+    {
+        std::decay_t<Space> S;
+        Arr lb;
+        Arr ub;
+    };
+
+    if (integer.size() != S.xc().size())
+    {
+        throw std::invalid_argument("branch_bound: integer does not fit x");
+    }
+
+    const auto t_orig = t;
+    auto incumbent = std::atomic<double> {t};
+    auto mtx = std::mutex {};
+    Arr x_best;
+    auto num_nodes = std::atomic<size_t> {0};
+    auto stopped = std::atomic<bool> {false};
+
+    auto improve = [&](double t1, const Arr& x1) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (t1 < incumbent.load())
+        {
+            incumbent.store(t1);
+            x_best = x1;
+        }
+    };
+
+    std::function<void(std::shared_ptr<Node>)> solve;
+    auto branch = [&](const Node& node, size_t i, bool upper, double v) {
+        auto child = std::make_shared<Node>(
+            Node {node.S.copy(), Arr(node.lb), Arr(node.ub)});
+        auto g = Arr {xt::zeros_like(child->lb)};
+        auto beta = child->S.xc()(i);
+        if (upper)
+        { // x_i \le v
+            child->ub(i) = v;
+            g(i) = 1.;
+            beta -= v;
+        }
+        else
+        { // x_i \ge v
+            child->lb(i) = v;
+            g(i) = -1.;
+            beta = v - beta;
+        }
+        if (child->lb(i) > child->ub(i))
+        {
+            return;
+        }
+        const auto cut = std::make_tuple(std::move(g), beta);
+        if (std::get<0>(child->S.update(cut)) == CUTStatus::nosoln)
+        {
+            return; // empty child
+        }
+        pool.submit([&solve, child] { solve(child); });
+    };
+
+    solve = [&](std::shared_ptr<Node> node) {
+        if (detail::interrupted(options))
+        {
+            stopped = true;
+            return;
+        }
+        ++num_nodes;
+
+        auto Omega = make_oracle();
+        auto P = detail::node_oracle<Oracle, Arr> {Omega, node->lb, node->ub};
+        auto S1 = node->S.copy();
+        auto t1 = incumbent.load();
+        const auto [x1, info] = cutting_plane_dc(P, S1, t1, options);
+        if (!info.feasible || t1 >= incumbent.load())
+        {
+            return; // pruned
+        }
+
+        auto xr = Arr(x1);
+        auto i_max = xr.size();
+        auto frac_max = int_tol;
+        for (auto i = 0U; i != xr.size(); ++i)
+        {
+            if (!integer[i])
+            {
+                continue;
+            }
+            xr(i) = std::round(x1(i));
+            const auto frac = std::abs(x1(i) - xr(i));
+            if (frac > frac_max)
+            {
+                frac_max = frac;
+                i_max = i;
+            }
+        }
+        auto tr = incumbent.load();
+        if (std::get<1>(Omega(xr, tr)))
+        { // rounding gives a better integral point
+            improve(tr, xr);
+        }
+        if (i_max == xr.size())
+        {
+            return; // integral
+        }
+        const auto v = x1(i_max);
+        branch(*node, i_max, true, std::floor(v));
+        branch(*node, i_max, false, std::ceil(v));
+    };
+
+    const auto inf = std::numeric_limits<double>::infinity();
+    const auto ones = Arr {xt::ones_like(S.xc())};
+    auto root = std::make_shared<Node>(
+        Node {S.copy(), Arr(-inf * ones), Arr(inf * ones)});
+    pool.submit([&solve, root] { solve(root); });
+    pool.wait_idle();
+
+    t = incumbent.load();
+    const auto status = stopped ? CUTStatus::timeout : CUTStatus::success;
+    return std::make_tuple(std::move(x_best),
+        CInfo {t != t_orig, num_nodes.load(), status});
+}
+
+/*!
+ * @brief Parallel branch and bound for mixed-integer convex problems
+ *
+ *    Same as above, with a pool of `n_workers` threads.
+ *
+ * @tparam Factory
+ * @tparam Space
+ * @param[in]     make_oracle returns a fresh oracle for cutting_plane_dc()
+ * @param[in]     S           search Space containing x*
+ * @param[in]     integer     which variables must be integral
+ * @param[in,out] t           best-so-far optimal value
+ * @param[in]     n_workers   number of worker threads
+ * @param[in]     options     for the relaxations
+ * @return x_best and Information (num_iters: number of nodes solved)
+ * @throw std::invalid_argument if integer does not have one entry per
+ *        variable
+ */
+template <typename Factory, typename Space>
+auto branch_bound(Factory&& make_oracle, const Space& S,
+    const std::vector<bool>& integer, double& t, size_t n_workers,
+    const Options& options = Options())
+{
+    auto pool = work_stealing_pool {n_workers};
+    return branch_bound(
+        pool, std::forward<Factory>(make_oracle), S, integer, t, options);
+}
@@ -1,13 +1,18 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <limits>
 
 enum class CUTStatus
 {
     success,
     nosoln,
     smallenough,
-    noeffect
+    noeffect,
+    timeout
 };
 
 /*!
@@ -18,6 +23,14 @@ struct Options
 {
     unsigned int max_it = 2000; //!< maximum number of iterations
     double tol = 1e-8;          //!< error tolerance
+    double cut_depth = 0.;      //!< lazy oracles: stop at a cut deeper than this
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::time_point::max(); //!< wall-clock limit
+    const std::atomic<bool>* cancel = nullptr; //!< cooperative cancellation
+    double gap_tol = 0.;  //!< stop once the optimality gap is below this
+                          //!< (oracles with a linear_objective only)
+    double gap_rtol = 0.; //!< ... or below this, relative to |t|
+    bool memoize = false; //!< cutting_plane_q: reuse cuts at discrete points
 };
 
 /*!
@@ -29,4 +42,48 @@ struct CInfo
     bool feasible;
     size_t num_iters;
     CUTStatus status;
+    double tsq = 0.; //!< last measure of the search space (quality indicator)
+    double gap = std::numeric_limits<double>::infinity(); //!< certified gap
 };
+
+namespace detail
+{
+
+/*!
+ * @brief Has the deadline passed or the cancellation been requested?
+ *
+ *    The clock is only read when a deadline is set.
+ *
+ * @param[in] options
+ * @return bool
+ */
+inline auto interrupted(const Options& options) -> bool
+{
+    using clock = std::chrono::steady_clock;
+    if (options.cancel != nullptr
+        && options.cancel->load(std::memory_order_relaxed))
+    {
+        return true;
+    }
+    return options.deadline != clock::time_point::max()
+        && clock::now() >= options.deadline;
+}
+
+/*!
+ * @brief Is the optimality gap small enough?
+ *
+ * @param[in] gap
+ * @param[in] t the best-so-far optimal value
+ * @param[in] options
+ * @return bool
+ */
+inline auto gap_closed(double gap, double t, const Options& options) -> bool
+{
+    if (options.gap_tol <= 0. && options.gap_rtol <= 0.)
+    {
+        return false; // disabled
+    }
+    return gap <= options.gap_tol || gap <= options.gap_rtol * std::abs(t);
+}
+
+} // namespace detail
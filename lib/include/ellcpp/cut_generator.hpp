@@ -0,0 +1,120 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <boost/coroutine2/all.hpp>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+/*!
+ * @brief Lazy cut generator (pull side)
+ *
+ *    An oracle that provides a member function `generate(x, ...)`
+ *    returning a cut_generator yields its candidate cuts at x one by one.
+ *    The driver pulls only as many cuts as it needs; the oracle resumes
+ *    exactly where it stopped. If the generator yields nothing, x is
+ *    feasible.
+ *
+ * @tparam T cut type, or std::tuple<Cut, bool> for cutting_plane_dc()
+ */
+template <typename T>
+using cut_generator = typename boost::coroutines2::coroutine<T>::pull_type;
+
+/*!
+ * @brief Lazy cut generator (push side, used inside the oracle)
+ *
+ * @tparam T cut type, or std::tuple<Cut, bool> for cutting_plane_dc()
+ */
+template <typename T>
+using cut_yield = typename boost::coroutines2::coroutine<T>::push_type;
+
+/*!
+ * @brief Stack allocator for cut generators
+ *
+ * Keep one per oracle so that the coroutine stacks are recycled
+ * instead of being mapped on every call.
+ */
+using cut_stack = boost::coroutines2::pooled_fixedsize_stack;
+
+namespace detail
+{
+
+template <typename Oracle, typename... Args>
+using generate_t =
+    decltype(std::declval<Oracle&>().generate(std::declval<Args>()...));
+
+template <typename Void, typename Oracle, typename... Args>
+struct has_generate_impl : std::false_type
+{
+};
+
+template <typename Oracle, typename... Args>
+struct has_generate_impl<std::void_t<generate_t<Oracle, Args...>>, Oracle,
+    Args...> : std::true_type
+{
+};
+
+/*!
+ * @brief Does `Oracle` follow the lazy cut generator protocol?
+ *
+ * @tparam Oracle
+ * @tparam Args arguments of `generate()`
+ */
+template <typename Oracle, typename... Args>
+constexpr bool has_generate_v =
+    has_generate_impl<void, std::decay_t<Oracle>, Args...>::value;
+
+/*!
+ * @brief Depth of a (single or parallel) cut
+ *
+ * @param[in] beta
+ * @return double
+ */
+inline auto cut_depth(const double& beta) -> double
+{
+    return beta;
+}
+
+template <typename Arr>
+auto cut_depth(const Arr& beta) -> double
+{
+    return beta[0];
+}
+
+/*!
+ * @brief Pull cuts until a deep enough one is found
+ *
+ *    Stop at the first cut whose depth exceeds `depth_tol`, otherwise
+ *    keep the deepest one seen before the generator runs dry.
+ *
+ * @tparam Gen
+ * @tparam Fn
+ * @param[in,out] cuts      cut generator
+ * @param[in]     get_depth depth of a generated element
+ * @param[in]     depth_tol
+ * @return std::optional of the chosen element (empty if none is yielded)
+ */
+template <typename Gen, typename Fn>
+auto pull_cut(Gen& cuts, Fn&& get_depth, double depth_tol)
+    -> std::optional<std::decay_t<decltype(cuts.get())>>
+{
+    std::optional<std::decay_t<decltype(cuts.get())>> best;
+    auto best_depth = 0.;
+    for (; cuts; cuts())
+    {
+        auto elem = cuts.get(); // note: get() moves the value out
+        const auto depth = get_depth(elem);
+        if (!best || depth > best_depth)
+        {
+            best = std::move(elem);
+            best_depth = depth;
+        }
+        if (depth > depth_tol)
+        {
+            break;
+        }
+    }
+    return best;
+}
+
+} // namespace detail
@@ -2,10 +2,392 @@
 #pragma once
 
 #include "cut_config.hpp"
+#include "cut_generator.hpp"
 #include "half_nonnegative.hpp"
+#include "point_memo.hpp"
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <limits>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace detail
+{
+
+/*!
+ * @brief Query a feasibility oracle at x
+ *
+ *    Lazy oracles (providing `generate(x)`) are pulled until a deep
+ *    enough cut is found; plain oracles are simply called.
+ *
+ * @return std::optional<Cut>
+ */
+template <typename Oracle, typename T>
+auto assess_feas(Oracle& Omega, const T& x, const Options& options)
+{
+    if constexpr (has_generate_v<Oracle, const T&>)
+    {
+        auto cuts = Omega.generate(x);
+        return pull_cut(
+            cuts,
+            [](const auto& cut) { return cut_depth(std::get<1>(cut)); },
+            options.cut_depth);
+    }
+    else
+    {
+        return Omega(x);
+    }
+}
+
+/*!
+ * @brief Query an optimization oracle at x
+ *
+ *    Lazy oracles (providing `generate(x, t)`) are pulled until a deep
+ *    enough cut is found. The objective cut (shrunk) is always taken.
+ *
+ * @return std::tuple<Cut, bool>
+ */
+template <typename Oracle, typename T, typename opt_type>
+auto assess_optim(
+    Oracle& Omega, const T& x, opt_type& t, const Options& options)
+{
+    if constexpr (has_generate_v<Oracle, const T&, opt_type&>)
+    {
+        auto cuts = Omega.generate(x, t);
+        auto elem = pull_cut(
+            cuts,
+            [](const auto& cut_shrunk)
+            {
+                const auto& [cut, shrunk] = cut_shrunk;
+                return shrunk ? std::numeric_limits<double>::infinity()
+                              : cut_depth(std::get<1>(cut));
+            },
+            options.cut_depth);
+        assert(elem); // at least the objective cut is yielded
+        return std::move(*elem);
+    }
+    else
+    {
+        return Omega(x, t);
+    }
+}
+
+template <typename T>
+struct type_tag
+{
+    using type = T;
+};
+
+template <typename Oracle, typename = void>
+struct has_cut_buffer_impl : std::false_type
+{
+};
+
+template <typename Oracle>
+struct has_cut_buffer_impl<Oracle, std::void_t<typename Oracle::cut_t>>
+    : std::true_type
+{
+};
+
+/*!
+ * @brief Does `Oracle` write its cuts into a buffer?
+ *
+ *    Such an oracle declares `cut_t` and provides
+ *
+ *        bool Omega(x, cut)    // feasibility: true if a cut is written
+ *        bool Omega(x, t, cut) // optimization: true if t is shrunk
+ *
+ *    or, for cutting_plane_q(),
+ *
+ *        Omega(x, t, retry, cut) // (const& x0, shrunk, more)
+ *
+ *    The driver keeps one buffer for the whole run, so that the oracle
+ *    does not allocate once the buffer has the right size.
+ *
+ * @tparam Oracle
+ */
+template <typename Oracle>
+constexpr bool has_cut_buffer_v =
+    has_cut_buffer_impl<std::decay_t<Oracle>>::value;
+
+template <typename Oracle, typename = void>
+struct has_linear_objective_impl : std::false_type
+{
+};
+
+template <typename Oracle>
+struct has_linear_objective_impl<Oracle,
+    std::enable_if_t<Oracle::linear_objective>> : std::true_type
+{
+};
+
+/*!
+ * @brief Is the objective cut of `Oracle` linear in t?
+ *
+ *    Such an oracle declares `static constexpr bool linear_objective =
+ *    true`: t is minimized, and its objective cut at xc is
+ *
+ *        g' (x - xc) + f(xc) - t \le 0,
+ *
+ *    with g a subgradient of f. Only then does f(xc) - sqrt(tsq) bound
+ *    the optimum from below (see cutting_plane_dc).
+ *
+ * @tparam Oracle
+ */
+template <typename Oracle>
+constexpr bool has_linear_objective_v =
+    has_linear_objective_impl<std::decay_t<Oracle>>::value;
+
+template <typename Oracle, typename T>
+auto feas_cut_tag()
+{
+    if constexpr (has_cut_buffer_v<Oracle>)
+    {
+        return type_tag<typename std::decay_t<Oracle>::cut_t> {};
+    }
+    else
+    {
+        using Result = decltype(assess_feas(std::declval<Oracle&>(),
+            std::declval<const T&>(), std::declval<const Options&>()));
+        return type_tag<typename Result::value_type> {};
+    }
+}
+
+template <typename Oracle, typename T, typename opt_type>
+auto optim_cut_tag()
+{
+    if constexpr (has_cut_buffer_v<Oracle>)
+    {
+        return type_tag<typename std::decay_t<Oracle>::cut_t> {};
+    }
+    else
+    {
+        using Result = decltype(assess_optim(std::declval<Oracle&>(),
+            std::declval<const T&>(), std::declval<opt_type&>(),
+            std::declval<const Options&>()));
+        return type_tag<std::decay_t<std::tuple_element_t<0, Result>>> {};
+    }
+}
+
+template <typename Oracle, typename T, typename opt_type>
+auto q_cut_tag()
+{
+    if constexpr (has_cut_buffer_v<Oracle>)
+    {
+        return type_tag<typename std::decay_t<Oracle>::cut_t> {};
+    }
+    else
+    {
+        using Result = decltype(std::declval<Oracle&>()(
+            std::declval<const T&>(), std::declval<opt_type&>(), false));
+        return type_tag<std::decay_t<std::tuple_element_t<0, Result>>> {};
+    }
+}
+
+/*!
+ * @brief Cut type of a feasibility oracle at x of type T
+ */
+template <typename Oracle, typename T>
+using feas_cut_t = typename decltype(feas_cut_tag<Oracle, T>())::type;
+
+/*!
+ * @brief Cut type of an optimization oracle at x of type T
+ */
+template <typename Oracle, typename T, typename opt_type>
+using optim_cut_t =
+    typename decltype(optim_cut_tag<Oracle, T, opt_type>())::type;
+
+/*!
+ * @brief Cut type of a discrete oracle (see cutting_plane_q) at x of
+ *        type T
+ */
+template <typename Oracle, typename T, typename opt_type>
+using q_cut_t = typename decltype(q_cut_tag<Oracle, T, opt_type>())::type;
+
+/*!
+ * @brief Query a feasibility oracle at x, writing the cut into `cut`
+ *
+ *    Oracles with a cut buffer write into it directly, unless a deep cut
+ *    is asked for and the oracle is also lazy.
+ *
+ * @return true if x is cut off
+ */
+template <typename Oracle, typename T, typename Cut>
+auto assess_feas(Oracle& Omega, const T& x, Cut& cut, const Options& options)
+    -> bool
+{
+    constexpr auto lazy = has_generate_v<Oracle, const T&>;
+    if constexpr (has_cut_buffer_v<Oracle> && !lazy)
+    {
+        return Omega(x, cut);
+    }
+    else
+    {
+        if constexpr (has_cut_buffer_v<Oracle>)
+        {
+            if (options.cut_depth <= 0.)
+            {
+                return Omega(x, cut);
+            }
+        }
+        auto res = assess_feas(Omega, x, options);
+        if (!res)
+        {
+            return false;
+        }
+        cut = std::move(*res);
+        return true;
+    }
+}
+
+/*!
+ * @brief Query an optimization oracle at x, writing the cut into `cut`
+ *
+ *    Oracles with a cut buffer write into it directly, unless a deep cut
+ *    is asked for and the oracle is also lazy.
+ *
+ * @return true if t is shrunk
+ */
+template <typename Oracle, typename T, typename opt_type, typename Cut>
+auto assess_optim(Oracle& Omega, const T& x, opt_type& t, Cut& cut,
+    const Options& options) -> bool
+{
+    constexpr auto lazy = has_generate_v<Oracle, const T&, opt_type&>;
+    if constexpr (has_cut_buffer_v<Oracle> && !lazy)
+    {
+        return Omega(x, t, cut);
+    }
+    else
+    {
+        if constexpr (has_cut_buffer_v<Oracle>)
+        {
+            if (options.cut_depth <= 0.)
+            {
+                return Omega(x, t, cut);
+            }
+        }
+        auto [res, shrunk] = assess_optim(Omega, x, t, options);
+        cut = std::move(res);
+        return shrunk;
+    }
+}
+
+/*!
+ * @brief Query a discrete oracle at x, writing the cut into `cut`
+ *
+ * @return the point assessed, whether t is shrunk, and whether another
+ *         cut can be tried
+ */
+template <typename Oracle, typename T, typename opt_type, typename Cut>
+auto assess_q(Oracle& Omega, const T& x, opt_type& t, bool retry, Cut& cut)
+{
+    if constexpr (has_cut_buffer_v<Oracle>)
+    {
+        return Omega(x, t, retry, cut); // x0 by reference
+    }
+    else
+    {
+        auto [res, x0, shrunk, more] = Omega(x, t, retry);
+        cut = std::move(res);
+        return std::tuple<T, bool, bool> {std::move(x0), shrunk, more};
+    }
+}
+
+template <typename Space>
+using xc_ref_t = decltype(std::declval<const Space&>().xc_ref());
+
+template <typename Void, typename Space>
+struct has_xc_ref_impl : std::false_type
+{
+};
+
+template <typename Space>
+struct has_xc_ref_impl<std::void_t<xc_ref_t<Space>>, Space> : std::true_type
+{
+};
+
+/*!
+ * @brief Center of the search space, without a copy if possible
+ *
+ * @return `S.xc_ref()` if the space provides it, `S.xc()` otherwise
+ */
+template <typename Space>
+auto center(const Space& S) -> decltype(auto)
+{
+    if constexpr (has_xc_ref_impl<void, Space>::value)
+    {
+        return S.xc_ref();
+    }
+    else
+    {
+        return S.xc();
+    }
+}
+
+/*!
+ * @brief The tolerance on a bracket width, in the type T of the bracket
+ *
+ *    For integral T, a width below tol is a width below ceil(tol). Other
+ *    types (e.g. `Fraction`) are not converted from a double: pass the
+ *    tolerance as a T instead.
+ *
+ * @tparam T
+ * @param[in] tol
+ * @return T
+ */
+template <typename T>
+auto tol_as(double tol) -> T
+{
+    static_assert(std::is_arithmetic_v<T>, "pass the tolerance as a T");
+    if constexpr (std::is_integral_v<T>)
+    {
+        return static_cast<T>(std::ceil(tol));
+    }
+    else
+    {
+        return static_cast<T>(tol);
+    }
+}
+
+template <typename Space>
+using enforce_bounds_t = decltype(std::declval<Space&>().enforce_bounds());
+
+template <typename Void, typename Space>
+struct has_bounds_impl : std::false_type
+{
+};
+
+template <typename Space>
+struct has_bounds_impl<std::void_t<enforce_bounds_t<Space>>, Space>
+    : std::true_type
+{
+};
+
+/*!
+ * @brief Apply the box constraints of the search space, if it has any
+ *
+ *    Spaces providing `enforce_bounds()` (see ell::set_bounds()) cut off
+ *    the violated bounds themselves, without an oracle call.
+ *
+ * @return CUTStatus::success if a bound cut is applied,
+ *         CUTStatus::noeffect if xc is within the bounds
+ */
+template <typename Space>
+auto enforce_bounds(Space& S) -> CUTStatus
+{
+    if constexpr (has_bounds_impl<void, std::decay_t<Space>>::value)
+    {
+        return S.enforce_bounds();
+    }
+    else
+    {
+        return CUTStatus::noeffect;
+    }
+}
+
+} // namespace detail
 
 
 /*!
@@ -23,6 +405,9 @@
  *
  *     A *separation oracle* asserts that an evalution point x0 is feasible,
  *     or provide a cut that separates the feasible region and x0.
+ *     The oracle may also be lazy, i.e. provide `generate(x0)` that
+ *     yields its candidate cuts one by one (see cut_generator), or write
+ *     its cut into a buffer reused across iterations (`Omega(x0, cut)`).
  *
  * @tparam Oracle
  * @tparam Space
@@ -35,19 +420,38 @@ template <typename Oracle, typename Space>
 auto cutting_plane_feas(
     Oracle&& Omega, Space&& S, const Options& options = Options()) -> CInfo
 {
+    using Arr = std::decay_t<decltype(S.xc())>;
     auto feasible = false;
     auto status = CUTStatus::success;
+    auto last_tsq = std::numeric_limits<double>::infinity();
+    auto cut = detail::feas_cut_t<Oracle, Arr> {};
 
     auto niter = 0U;
     while (++niter != options.max_it)
     {
-        const auto cut = Omega(S.xc()); // query the oracle at S.xc()
-        if (!cut)
+        if (detail::interrupted(options))
+        { // out of time: return the best-so-far
+            status = CUTStatus::timeout;
+            break;
+        }
+        const auto bstatus = detail::enforce_bounds(S);
+        if (bstatus == CUTStatus::nosoln)
+        {
+            status = bstatus;
+            break;
+        }
+        if (bstatus == CUTStatus::success)
+        {
+            continue; // xc moved: check the bounds again
+        }
+        // query the oracle at S.xc()
+        if (!detail::assess_feas(Omega, detail::center(S), cut, options))
         { // feasible sol'n obtained
             feasible = true;
             break;
         }
-        const auto [cutstatus, tsq] = S.update(*cut); // update S
+        const auto [cutstatus, tsq] = S.update(cut); // update S
+        last_tsq = tsq;
         if (cutstatus != CUTStatus::success)
         {
             status = cutstatus;
@@ -59,12 +463,30 @@ auto cutting_plane_feas(
             break;
         }
     }
-    return {feasible, niter, status};
+    return {feasible, niter, status, last_tsq};
 }
 
 /*!
  * @brief Cutting-plane method for solving convex problem
  *
+ * The oracle is either called as `Omega(x0, t)`, or as `Omega(x0, t, cut)`
+ * with a buffer reused across iterations if it declares `cut_t`, or, if
+ * it provides `generate(x0, t)`, pulled lazily (see cut_generator). It is
+ * only called once x0 is within the box constraints of the search space,
+ * if any (see ell::set_bounds()).
+ *
+ * Anytime mode: once `options.deadline` has passed or `*options.cancel`
+ * is set, the method stops with CUTStatus::timeout; x_best and t hold the
+ * best-so-far and CInfo::tsq tells how far from converged it is.
+ *
+ * Gap: if the oracle declares a floating-point objective cut
+ * g' (x - xc) + f(xc) - t \le 0 (see detail::has_linear_objective_v),
+ * each shrunk iteration certifies f* \ge f(xc) - sqrt(tsq). The best
+ * such bound gives CInfo::gap, and the method stops with
+ * CUTStatus::smallenough once it is within `options.gap_tol` or
+ * `options.gap_rtol * |t|`. Other oracles get no gap (infinity), and
+ * the gap options are ignored.
+ *
  * @tparam Oracle
  * @tparam Space
  * @tparam opt_type
@@ -78,19 +500,53 @@ template <typename Oracle, typename Space, typename opt_type>
 auto cutting_plane_dc(
     Oracle&& Omega, Space&& S, opt_type&& t, const Options& options = Options())
 {
+    using value_type = std::decay_t<opt_type>;
+    using Arr = std::decay_t<decltype(S.xc())>;
+    constexpr auto with_gap = std::is_floating_point_v<value_type>
+        && detail::has_linear_objective_v<Oracle>;
     const auto t_orig = t;
-    decltype(S.xc()) x_best;
+    Arr x_best;
+    auto cut = detail::optim_cut_t<Oracle, Arr, value_type> {};
     auto status = CUTStatus::success;
+    auto last_tsq = std::numeric_limits<double>::infinity();
+    auto lower = -std::numeric_limits<double>::infinity();
+    auto gap = std::numeric_limits<double>::infinity();
 
     auto niter = 0U;
     while (++niter != options.max_it)
     {
-        const auto [cut, shrunk] = Omega(S.xc(), t);
+        if (detail::interrupted(options))
+        { // out of time: return the best-so-far
+            status = CUTStatus::timeout;
+            break;
+        }
+        const auto bstatus = detail::enforce_bounds(S);
+        if (bstatus == CUTStatus::nosoln)
+        {
+            status = bstatus;
+            break;
+        }
+        if (bstatus == CUTStatus::success)
+        {
+            continue; // xc moved: check the bounds again
+        }
+        const auto& xc = detail::center(S);
+        const auto shrunk = detail::assess_optim(Omega, xc, t, cut, options);
         if (shrunk)
         { // best t obtained
-            x_best = S.xc();
+            x_best = xc;
         }
         const auto [cutstatus, tsq] = S.update(cut);
+        last_tsq = tsq;
+        if constexpr (with_gap)
+        {
+            if (shrunk)
+            { // f* >= f(xc) - sqrt(tsq), where f(xc) = t + beta
+                const auto beta = detail::cut_depth(std::get<1>(cut));
+                lower = std::max(lower, t + beta - std::sqrt(tsq));
+                gap = t - lower;
+            }
+        }
         if (cutstatus != CUTStatus::success) // ???
         {
             status = cutstatus;
@@ -101,9 +557,17 @@ auto cutting_plane_dc(
             status = CUTStatus::smallenough;
             break;
         }
+        if constexpr (with_gap)
+        {
+            if (detail::gap_closed(gap, t, options))
+            { // t is within tolerance of the optimum
+                status = CUTStatus::smallenough;
+                break;
+            }
+        }
     }
-    return std::make_tuple(
-        std::move(x_best), CInfo {t != t_orig, niter, status});
+    return std::make_tuple(std::move(x_best),
+        CInfo {t != t_orig, niter, status, last_tsq, gap});
 } // END
 
 /*!
@@ -126,6 +590,13 @@ auto cutting_plane_dc(
 /*!
  * @brief Cutting-plane method for solving convex discrete optimization problem
  *
+ * Stops with CUTStatus::timeout on deadline or cancellation, as
+ * cutting_plane_dc() does.
+ *
+ * With `options.memoize`, an oracle that provides `discretize(x)` is
+ * not called again at a discrete point it has already assessed for the
+ * current t; the stored cut is re-targeted instead (see point_memo).
+ *
  * @tparam Oracle
  * @tparam Space
  * @param[in,out] Omega perform assessment on x0
@@ -138,21 +609,74 @@ template <typename Oracle, typename Space, typename opt_type>
 auto cutting_plane_q(
     Oracle&& Omega, Space&& S, opt_type&& t, const Options& options = Options())
 {
+    using Arr = std::decay_t<decltype(S.xc())>;
+    using Cut = detail::q_cut_t<Oracle, Arr, std::decay_t<opt_type>>;
+    constexpr auto can_memoize = detail::has_discretize_v<Oracle, const Arr&>;
+
     const auto t_orig = t;
-    decltype(S.xc()) x_best;
+    Arr x_best;
+    auto cut = Cut {};
     auto status = CUTStatus::nosoln; // note!!!
+    auto last_tsq = std::numeric_limits<double>::infinity();
+    auto memo = detail::point_memo<Arr, Cut, std::decay_t<opt_type>> {};
 
     auto niter = 0U;
     while (++niter != options.max_it)
     {
-        auto retry = (status == CUTStatus::noeffect);
-        const auto [cut, x0, shrunk, more_alt] = Omega(S.xc(), t, retry);
-        if (shrunk)
-        { // best t obtained
-            // t = t1;
-            x_best = x0;
+        if (detail::interrupted(options))
+        { // out of time: return the best-so-far
+            status = CUTStatus::timeout;
+            break;
         }
-        const auto [cutstatus, tsq] = S.update(cut);
+        const auto bstatus = detail::enforce_bounds(S);
+        if (bstatus == CUTStatus::nosoln)
+        {
+            status = bstatus;
+            break;
+        }
+        if (bstatus == CUTStatus::success)
+        {
+            continue; // xc moved: check the bounds again
+        }
+        const auto retry = (status == CUTStatus::noeffect);
+        auto more_alt = true;
+        auto result = std::tuple<CUTStatus, double> {};
+        Cut* cached = nullptr;
+        if constexpr (can_memoize)
+        {
+            if (options.memoize && !retry)
+            {
+                const auto& xc = detail::center(S);
+                const auto& xd = Omega.discretize(xc);
+                cached = memo.find(xd, t);
+                if (cached != nullptr)
+                { // evaluated before: re-target the stored cut
+                    result = memo.update(S, *cached, xd, xc);
+                }
+            }
+        }
+        if (cached == nullptr)
+        {
+            const auto& xc = detail::center(S);
+            const auto [x0, shrunk, more] =
+                detail::assess_q(Omega, xc, t, retry, cut);
+            if (shrunk)
+            { // best t obtained
+                // t = t1;
+                x_best = x0;
+            }
+            else if constexpr (can_memoize)
+            {
+                if (options.memoize && !retry)
+                {
+                    memo.store(x0, cut, xc, t);
+                }
+            }
+            result = S.update(cut);
+            more_alt = more;
+        }
+        const auto [cutstatus, tsq] = result;
+        last_tsq = tsq;
         if (cutstatus == CUTStatus::noeffect)
         {
             if (!more_alt)
@@ -172,7 +696,7 @@ auto cutting_plane_q(
         }
     }
     return std::make_tuple(
-        std::move(x_best), CInfo {t != t_orig, niter, status});
+        std::move(x_best), CInfo {t != t_orig, niter, status, last_tsq});
 } // END
 
 /*!
@@ -180,13 +704,15 @@ auto cutting_plane_q(
  *
  * @tparam Oracle
  * @tparam Space
+ * @tparam T
  * @param[in,out] Omega    perform assessment on x0
  * @param[in,out] I        interval containing x*
- * @param[in]     options  maximum iteration and error tolerance etc.
+ * @param[in]     options  maximum iteration (options.tol is not used)
+ * @param[in]     tol      tolerance on the half width, of the type of I
  * @return CInfo
  */
-template <typename Oracle, typename Space>
-auto bsearch(Oracle&& Omega, Space&& I, const Options& options = Options())
+template <typename Oracle, typename Space, typename T>
+auto bsearch(Oracle&& Omega, Space&& I, const Options& options, const T& tol)
     -> CInfo
 {
     // assume monotone
@@ -201,7 +727,7 @@ auto bsearch(Oracle&& Omega, Space&& I, const Options& options = Options())
     for (; niter != options.max_it; ++niter)
     {
         auto tau = algo::half_nonnegative(upper - lower);
-        if (tau < options.tol)
+        if (tau < tol)
         {
             status = CUTStatus::smallenough;
             break;
@@ -221,6 +747,227 @@ auto bsearch(Oracle&& Omega, Space&& I, const Options& options = Options())
     return {upper != u_orig, niter + 1, status};
 }
 
+/*!
+ * @brief
+ *
+ * @tparam Oracle
+ * @tparam Space
+ * @param[in,out] Omega    perform assessment on x0
+ * @param[in,out] I        interval containing x*
+ * @param[in]     options  maximum iteration and error tolerance etc.
+ * @return CInfo
+ */
+template <typename Oracle, typename Space>
+auto bsearch(Oracle&& Omega, Space&& I, const Options& options = Options())
+    -> CInfo
+{
+    using T = std::decay_t<decltype(I.first)>;
+    return bsearch(std::forward<Oracle>(Omega), std::forward<Space>(I),
+        options, detail::tol_as<T>(options.tol));
+}
+
+/*!
+ * @brief Binary search with a galloping start
+ *
+ *    Instead of a given interval, start from a hint: step away from it,
+ *    doubling the step, until the feasibility changes, then bisect the
+ *    bracket with bsearch(). Assume monotone, i.e. Omega(t) is feasible
+ *    for all t >= t*.
+ *
+ * @tparam Oracle
+ * @tparam T integral, floating-point or `Fraction`
+ * @param[in,out] Omega   perform assessment on t
+ * @param[in]     hint    initial guess of t*
+ * @param[in]     scale   initial step (> 0)
+ * @param[in]     options maximum iteration (options.tol is not used)
+ * @param[in]     tol     tolerance on the half width of the bracket
+ * @return the final interval (lower, upper) and CInfo
+ */
+template <typename Oracle, typename T>
+auto bsearch_gallop(Oracle&& Omega, const T& hint, T scale,
+    const Options& options, const T& tol)
+    -> std::tuple<std::pair<T, T>, CInfo>
+{
+    auto I = std::make_pair(hint, hint);
+    auto& lower = I.first;
+    auto& upper = I.second;
+    auto step = std::move(scale);
+
+    auto niter = 1U;
+    auto bracketed = false;
+    if (Omega(hint))
+    { // gallop downward
+        while (niter < options.max_it)
+        {
+            auto t = upper; // may be `int` or `Fraction`
+            t -= step;
+            ++niter;
+            if (!Omega(t))
+            {
+                lower = t;
+                bracketed = true;
+                break;
+            }
+            upper = t;
+            step += step;
+        }
+        if (!bracketed)
+        {
+            return {I, CInfo {true, niter, CUTStatus::nosoln}};
+        }
+    }
+    else
+    { // gallop upward
+        while (niter < options.max_it)
+        {
+            auto t = lower;
+            t += step;
+            ++niter;
+            if (Omega(t))
+            {
+                upper = t;
+                bracketed = true;
+                break;
+            }
+            lower = t;
+            step += step;
+        }
+        if (!bracketed)
+        {
+            return {I, CInfo {false, niter, CUTStatus::nosoln}};
+        }
+    }
+
+    auto bs_options = options;
+    bs_options.max_it = options.max_it - niter;
+    auto info = bsearch(Omega, I, bs_options, tol);
+    info.feasible = true; // upper is feasible
+    info.num_iters += niter;
+    return {I, info};
+}
+
+/*!
+ * @brief Same as above, with the tolerance options.tol
+ *
+ * @tparam Oracle
+ * @tparam T integral or floating-point (see detail::tol_as)
+ * @param[in,out] Omega   perform assessment on t
+ * @param[in]     hint    initial guess of t*
+ * @param[in]     scale   initial step (> 0)
+ * @param[in]     options maximum iteration and error tolerance etc.
+ * @return the final interval (lower, upper) and CInfo
+ */
+template <typename Oracle, typename T>
+auto bsearch_gallop(Oracle&& Omega, const T& hint, T scale,
+    const Options& options = Options()) -> std::tuple<std::pair<T, T>, CInfo>
+{
+    return bsearch_gallop(std::forward<Oracle>(Omega), hint,
+        std::move(scale), options, detail::tol_as<T>(options.tol));
+}
+
+/*!
+ * @brief Interpolation search using the slack reported by the oracle
+ *
+ *    Like bsearch(), but `Omega(t)` returns std::tuple<bool, double>:
+ *    the feasibility and a signed slack s(t), increasing in t, with
+ *    s >= 0 when feasible and s < 0 (minus the violation) otherwise.
+ *    The next probe is the regula falsi root of s over the bracket, with
+ *    the Illinois modification, kept at least `tol` away from the ends.
+ *    A bisection step is taken whenever two steps in a row fail to halve
+ *    the bracket, or when no slack is known at one end yet.
+ *
+ *    The slack must be a function of t alone. The slack of whatever point
+ *    an inner cutting-plane run ends on (see bsearch_adaptor) is not
+ *    monotone in t: use bsearch() there.
+ *
+ * @tparam Oracle
+ * @tparam Space std::pair of a floating-point type
+ * @param[in,out] Omega    perform assessment on t
+ * @param[in,out] I        interval containing t* (lower infeasible)
+ * @param[in]     options  maximum iteration and error tolerance etc.
+ * @return CInfo
+ */
+template <typename Oracle, typename Space>
+auto bsearch_slack(Oracle&& Omega, Space&& I,
+    const Options& options = Options()) -> CInfo
+{
+    using T = std::decay_t<decltype(I.first)>;
+    static_assert(std::is_floating_point_v<T>, "floating-point only");
+
+    auto& lower = I.first;
+    auto& upper = I.second;
+    assert(lower <= upper);
+    const auto u_orig = upper;
+    auto status = CUTStatus::success;
+
+    auto s_lo = T(0); // slack at lower, once known (< 0)
+    auto s_hi = T(0); // slack at upper, once known (>= 0)
+    auto known = 0U;    // bit 0: s_lo, bit 1: s_hi
+    auto last_side = 0; // -1: lower moved, +1: upper moved
+    auto w_ref = upper - lower;
+    auto n_interp = 0U;
+    auto bisect = true;
+
+    auto niter = 0U;
+    for (; niter != options.max_it; ++niter)
+    {
+        const auto w = upper - lower;
+        if (w / 2 < options.tol)
+        {
+            status = CUTStatus::smallenough;
+            break;
+        }
+
+        auto t = lower + algo::half_nonnegative(w);
+        if (!bisect && known == 3U && s_hi - s_lo > 0)
+        { // regula falsi, safeguarded
+            t = lower - s_lo * (w / (s_hi - s_lo));
+            t = std::clamp(t, lower + options.tol, upper - options.tol);
+        }
+
+        const auto [feasible, slack] = Omega(t);
+        if (feasible)
+        {
+            upper = t;
+            s_hi = std::max(T(slack), T(0));
+            known |= 2U;
+            if (last_side == 1)
+            { // Illinois: the other end is stuck
+                s_lo /= 2;
+            }
+            last_side = 1;
+        }
+        else
+        {
+            lower = t;
+            s_lo = std::min(T(slack), T(0));
+            known |= 1U;
+            if (last_side == -1)
+            {
+                s_hi /= 2;
+            }
+            last_side = -1;
+        }
+
+        if (bisect)
+        { // restart the progress check
+            bisect = false;
+            w_ref = upper - lower;
+            n_interp = 0U;
+        }
+        else if (upper - lower <= w_ref / 2)
+        { // good progress
+            w_ref = upper - lower;
+            n_interp = 0U;
+        }
+        else if (++n_interp == 2U)
+        { // stalled: bisect next
+            bisect = true;
+        }
+    }
+    return {upper != u_orig, niter + 1, status}; // as bsearch() counts
+}
+
 /*!
  * @brief
  *
@@ -0,0 +1,152 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include "cutting_plane.hpp"
+#include "work_stealing_pool.hpp"
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <xtensor-blas/xlinalg.hpp>
+
+/*!
+ * @brief Cutting-plane method with parallel probing
+ *
+ *    Each round, the oracle is called concurrently at the center and at
+ *    `Omegas.size() - 1` probe points spread inside the search space
+ *    (see ell::probe_points()), one oracle copy per point.
+ *    The best t among the probes is kept. The cut at the center is
+ *    applied first, as in cutting_plane_dc(); the probe cuts
+ *
+ *        g' (x - p) + beta \le 0
+ *
+ *    are then re-targeted to the moving center (beta + g' (xc - p)) and
+ *    applied in turn, skipping those without effect.
+ *
+ *    As with cut_pool, cuts obtained with a larger t must stay valid for
+ *    the final t, which holds when t only enters them through f(x) - t.
+ *
+ * @tparam Oracle
+ * @tparam Space
+ * @tparam opt_type
+ * @param[in]     pool   one task per probe point
+ * @param[in,out] Omegas independent copies of the oracle
+ * @param[in,out] S      search Space containing x*
+ * @param[in,out] t      best-so-far optimal sol'n
+ * @param[in]     scale  probe distance, as a fraction of the semi-axes
+ * @param[in]     options maximum iteration and error tolerance etc.
+ * @return Information of Cutting-plane method
+ * @throw std::invalid_argument if Omegas is empty
+ */
+template <typename Oracle, typename Space, typename opt_type>
+auto cutting_plane_probe(work_stealing_pool& pool, std::vector<Oracle>& Omegas,
+    Space&& S, opt_type&& t, double scale = 0.5,
+    const Options& options = Options())
+{
+    using Arr = decltype(S.xc());
+    using Result = decltype(Omegas[0](std::declval<const Arr&>(), t));
+
+    if (Omegas.empty())
+    { // the center needs an oracle of its own
+        throw std::invalid_argument("cutting_plane_probe: no oracle");
+    }
+
+    const auto t_orig = t;
+    Arr x_best;
+    auto status = CUTStatus::success;
+    auto last_tsq = std::numeric_limits<double>::infinity();
+
+    const auto k = Omegas.size();
+    auto points = std::vector<Arr>(k);
+    auto ts = std::vector<std::decay_t<opt_type>>(k);
+    auto results = std::vector<Result>(k);
+
+    auto niter = 0U;
+    while (++niter != options.max_it)
+    {
+        if (detail::interrupted(options))
+        { // out of time: return the best-so-far
+            status = CUTStatus::timeout;
+            break;
+        }
+
+        points[0] = S.xc();
+        auto probes = S.probe_points(k - 1, scale);
+        const auto m = 1 + probes.size();
+        std::move(probes.begin(), probes.end(), points.begin() + 1);
+        for (auto j = 0U; j != m; ++j)
+        {
+            ts[j] = t;
+            pool.submit([&, j] { results[j] = Omegas[j](points[j], ts[j]); });
+        }
+        pool.wait_idle();
+
+        for (auto j = 0U; j != m; ++j)
+        {
+            if (std::get<1>(results[j]) && ts[j] < t)
+            { // best t obtained
+                t = ts[j];
+                x_best = points[j];
+            }
+        }
+
+        const auto [cutstatus, tsq] = S.update(std::get<0>(results[0]));
+        last_tsq = tsq;
+        if (cutstatus != CUTStatus::success)
+        {
+            status = cutstatus;
+            break;
+        }
+        if (tsq < options.tol)
+        { // no more
+            status = CUTStatus::smallenough;
+            break;
+        }
+
+        for (auto j = 1U; j != m; ++j)
+        {
+            auto& cut = std::get<0>(results[j]);
+            auto& [g, beta] = cut;
+            const auto xc = S.xc();
+            beta += xt::linalg::dot(g, xc)();
+            beta -= xt::linalg::dot(g, points[j])();
+            if (std::get<0>(S.update(cut)) == CUTStatus::nosoln)
+            {
+                status = CUTStatus::nosoln;
+                break;
+            }
+        }
+        if (status == CUTStatus::nosoln)
+        {
+            break;
+        }
+    }
+    return std::make_tuple(
+        std::move(x_best), CInfo {t != t_orig, niter, status, last_tsq});
+}
+
+/*!
+ * @brief Cutting-plane method with parallel probing
+ *
+ *    Same as above, with a pool of one thread per oracle copy.
+ *
+ * @tparam Oracle
+ * @tparam Space
+ * @tparam opt_type
+ * @param[in,out] Omegas independent copies of the oracle
+ * @param[in,out] S      search Space containing x*
+ * @param[in,out] t      best-so-far optimal sol'n
+ * @param[in]     scale  probe distance, as a fraction of the semi-axes
+ * @param[in]     options maximum iteration and error tolerance etc.
+ * @return Information of Cutting-plane method
+ * @throw std::invalid_argument if Omegas is empty
+ */
+template <typename Oracle, typename Space, typename opt_type>
+auto cutting_plane_probe(std::vector<Oracle>& Omegas, Space&& S,
+    opt_type&& t, double scale = 0.5, const Options& options = Options())
+{
+    auto pool = work_stealing_pool {Omegas.size()};
+    return cutting_plane_probe(pool, Omegas, std::forward<Space>(S),
+        std::forward<opt_type>(t), scale, options);
+}
@@ -4,6 +4,8 @@
 #include <cmath>
 #include <ellcpp/utility.hpp>
 #include <tuple>
+#include <utility>
+#include <vector>
 #include <xtensor/xarray.hpp>
 
 // forward declaration
@@ -49,6 +51,9 @@ class ell
     double _kappa;
     Arr _Q;
     Arr _xc;
+    Arr _lb; //!< lower bounds of x (unset by default)
+    Arr _ub; //!< upper bounds of x
+    Arr _Qg; //!< scratch for Q g, reused across updates
 
     /*!
      * @brief Construct a new ell object
@@ -147,6 +152,16 @@ class ell
         return _xc;
     }
 
+    /*!
+     * @brief The center, without a copy
+     *
+     * @return const Arr&
+     */
+    [[nodiscard]] auto xc_ref() const -> const Arr&
+    {
+        return _xc;
+    }
+
     /*!
      * @brief Set the xc object
      *
@@ -157,6 +172,50 @@ class ell
         _xc = xc;
     }
 
+    /*!
+     * @brief Set box constraints lb \le x \le ub
+     *
+     * Use -inf or +inf for a missing bound.
+     *
+     * @param[in] lb
+     * @param[in] ub
+     */
+    void set_bounds(Arr lb, Arr ub)
+    {
+        _lb = std::move(lb);
+        _ub = std::move(ub);
+    }
+
+    /*!
+     * @brief Cut off the part of the ellipsoid outside the box
+     *
+     * All the bounds violated by xc are combined into one cut
+     *
+     *        sum_i s_i (x_i - xc_i) + sum_i v_i \le 0
+     *
+     * where s_i = +-1 and v_i is the violation. Since g is sparse, Q g
+     * only takes the corresponding columns of Q.
+     *
+     * @return CUTStatus::noeffect if xc is within the box
+     */
+    auto enforce_bounds() -> CUTStatus;
+
+    /*!
+     * @brief Points inside the ellipsoid along the columns of a pivoted
+     *        Cholesky factor of Q
+     *
+     *        xc +- scale * sqrt(kappa) * u_j
+     *
+     * where Q = sum_j u_j u_j' and u_j pivots on the largest remaining
+     * diagonal: the first pair spans the coordinate of largest extent.
+     *
+     * @param[in] k     number of points (at most 2 n)
+     * @param[in] scale fraction of the semi-axis, in (0, 1)
+     * @return std::vector<Arr>
+     */
+    [[nodiscard]] auto probe_points(size_t k, double scale) const
+        -> std::vector<Arr>;
+
     /*!
      * @brief Update ellipsoid core function using the cut(s)
      *
@@ -168,6 +227,28 @@ class ell
     auto update(const std::tuple<Arr, T>& cut) -> std::tuple<CUTStatus, double>;
 
   protected:
+    /*!
+     * @brief Aggregated cut of the bounds violated by xc
+     *
+     * @param[out] g
+     * @param[out] beta
+     * @return false if xc is within the box
+     */
+    auto _bounds_cut(Arr& g, double& beta) const -> bool;
+
+    /*!
+     * @brief Update xc and Q, given Q g and g' Q g
+     *
+     * @tparam T
+     * @param[in] Qg
+     * @param[in] omega
+     * @param[in] beta
+     * @return CUTStatus
+     */
+    template <typename T>
+    auto _update_core(const Arr& Qg, const double& omega, const T& beta)
+        -> CUTStatus;
+
     auto _update_cut(const double& beta) -> CUTStatus
     {
         return this->_calc_dc(beta);
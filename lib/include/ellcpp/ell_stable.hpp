@@ -18,6 +18,12 @@ class ell_stable : public ell
   public:
     using Arr = xt::xarray<double, xt::layout_type::row_major>;
 
+  private:
+    Arr _invLg;     //!< scratch for inv(L) g, reused across updates
+    Arr _invDinvLg; //!< scratch for inv(D) inv(L) g
+    Arr _gQg;       //!< scratch for the terms of g' Q g
+
+  public:
     /*!
      * @brief Construct a new ell_stable object
      *
@@ -72,6 +78,22 @@ class ell_stable : public ell
         return ell_stable(*this);
     }
 
+    /*!
+     * @brief Not available: Q holds an LDLT factorization here
+     */
+    auto probe_points(size_t k, double scale) const
+        -> std::vector<Arr> = delete;
+
+    /*!
+     * @brief Cut off the part of the ellipsoid outside the box
+     *
+     * Overwrite the base class: the aggregated cut goes through update(),
+     * since the columns of Q are not at hand.
+     *
+     * @return CUTStatus::noeffect if xc is within the box
+     */
+    auto enforce_bounds() -> CUTStatus;
+
     /*!
      * @brief Update ellipsoid core function using the cut(s)
      *
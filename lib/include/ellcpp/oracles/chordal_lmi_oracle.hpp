@@ -0,0 +1,102 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include "sparse_lmi_oracle.hpp"
+#include "sparse_matrices.hpp"
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <vector>
+#include <xtensor/xarray.hpp>
+
+/*!
+ * @brief Oracle for large sparse Linear Matrix Inequality, by chordal
+ *        decomposition
+ *
+ *    This oracle solves the following feasibility problem:
+ *
+ *        find  x
+ *        s.t.  (B - F * x) >= 0
+ *
+ *    At construction, the aggregate sparsity pattern of B, F_1, F_2, ...
+ *    is split into connected components, and each component into the
+ *    cliques of its chordal extension (maximum cardinality search
+ *    ordering, then elimination). Then:
+ *
+ *    - B - F * x >= 0 iff each component block is, so the components are
+ *      assessed independently (in parallel when worthwhile);
+ *    - within a component, the clique blocks are principal submatrices:
+ *      each is factored first, as any violated one gives a cut at the
+ *      cost of the clique. If none is violated, the whole component is
+ *      factored to certify it (unless it is itself a clique).
+ *
+ *    For block-diagonal or chordal patterns with small cliques, the cost
+ *    of a cut drops from O(m^3) to about the sum of the cubes of the
+ *    clique sizes.
+ */
+class chordal_lmi_oracle
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+    using Cut = std::tuple<Arr, double>;
+
+  public:
+    using cut_t = Cut; //!< cut buffer type (see cutting_plane_feas)
+
+  private:
+    //! per component: the clique blocks, then the whole component
+    std::vector<std::vector<sparse_lmi_oracle>> _checks;
+    std::vector<std::vector<size_t>> _cliques;
+    size_t _work = 0; //!< sum of the cubes of the component sizes
+
+  public:
+    /*!
+     * @brief Construct a new chordal lmi oracle object
+     *
+     * @param[in] m dimension
+     * @param[in] F
+     * @param[in] B
+     */
+    chordal_lmi_oracle(
+        size_t m, const std::vector<coo_matrix>& F, const coo_matrix& B);
+
+    /*!
+     * @brief
+     *
+     * @param[in] x
+     * @return std::optional<Cut>
+     */
+    auto operator()(const Arr& x) -> std::optional<Cut>;
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer
+     *
+     *    When several components are violated, the cut of the first one
+     *    is returned, also in parallel mode.
+     *
+     * @param[in] x
+     * @param[out] cut
+     * @return true if x is cut off
+     */
+    auto operator()(const Arr& x, Cut& cut) -> bool;
+
+    /*!
+     * @brief Number of connected components of the pattern
+     *
+     * @return size_t
+     */
+    [[nodiscard]] auto num_components() const -> size_t
+    {
+        return this->_checks.size();
+    }
+
+    /*!
+     * @brief Maximal cliques of the chordal extension (sorted rows)
+     *
+     * @return const std::vector<std::vector<size_t>>&
+     */
+    [[nodiscard]] auto cliques() const
+        -> const std::vector<std::vector<size_t>>&
+    {
+        return this->_cliques;
+    }
+};
@@ -0,0 +1,178 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <numeric>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+/*!
+ * @brief Composite feasibility oracle with adaptive check ordering
+ *
+ *    The sub-oracles are asked in turn until one of them returns a cut.
+ *    For each of them, the number of calls, the number of violations and
+ *    the time spent are recorded. Every `reorder_period` calls, the
+ *    checks are reordered by increasing
+ *
+ *        c_i / p_i
+ *
+ *    where c_i is the mean cost of a call and p_i = (v_i + 1) / (n_i + 2)
+ *    the (smoothed) probability that the call finds a violation. This
+ *    order minimizes the expected time to the first violated cut when the
+ *    checks are independent.
+ *
+ *    In deterministic mode, the clock is not read and c_i is taken from
+ *    `weights` instead, so that the order (and hence the sequence of
+ *    cuts) only depends on the points visited.
+ *
+ * @tparam Oracles feasibility oracles with the same Cut type
+ */
+template <typename... Oracles>
+class composite_oracle
+{
+    static constexpr auto N = sizeof...(Oracles);
+
+  public:
+    /*!
+     * @brief Statistics of a sub-oracle
+     */
+    struct stats
+    {
+        size_t calls = 0;
+        size_t violations = 0;
+        double seconds = 0.;
+    };
+
+    bool deterministic = false; //!< use `weights` instead of timing
+    size_t reorder_period = 16; //!< calls between two reorderings
+    std::array<double, N> weights; //!< cost estimates in deterministic mode
+
+  private:
+    std::tuple<Oracles...> _oracles;
+    std::array<stats, N> _stats {};
+    std::array<size_t, N> _order;
+    size_t _calls = 0;
+
+  public:
+    /*!
+     * @brief Construct a new composite oracle object
+     *
+     * @param[in] oracles sub-oracles, in the initial order of checking
+     */
+    explicit composite_oracle(Oracles... oracles)
+        : _oracles {std::move(oracles)...}
+    {
+        this->weights.fill(1.);
+        std::iota(this->_order.begin(), this->_order.end(), 0U);
+    }
+
+    /*!
+     * @brief Feasibility protocol
+     *
+     * @param[in] x
+     * @return std::optional<Cut> the first violated cut, if any
+     */
+    template <typename T>
+    auto operator()(const T& x)
+    {
+        using Result = decltype(std::get<0>(this->_oracles)(x));
+        using clock = std::chrono::steady_clock;
+
+        if (this->reorder_period != 0
+            && ++this->_calls % this->reorder_period == 0)
+        {
+            this->_reorder();
+        }
+        for (const auto i : this->_order)
+        {
+            auto& s = this->_stats[i];
+            ++s.calls;
+            auto cut = Result {};
+            if (this->deterministic)
+            {
+                cut = this->template _call<Result>(i, x);
+            }
+            else
+            {
+                const auto start = clock::now();
+                cut = this->template _call<Result>(i, x);
+                s.seconds += std::chrono::duration<double>(
+                    clock::now() - start).count();
+            }
+            if (cut)
+            {
+                ++s.violations;
+                return cut;
+            }
+        }
+        return Result {};
+    }
+
+    /*!
+     * @brief Current order of checking
+     *
+     * @return const std::array<size_t, N>&
+     */
+    [[nodiscard]] auto order() const -> const std::array<size_t, N>&
+    {
+        return this->_order;
+    }
+
+    /*!
+     * @brief Statistics of the i-th sub-oracle
+     *
+     * @param[in] i
+     * @return const stats&
+     */
+    [[nodiscard]] auto statistics(size_t i) const -> const stats&
+    {
+        return this->_stats[i];
+    }
+
+  private:
+    /*!
+     * @brief Call the i-th sub-oracle
+     */
+    template <typename Result, typename T>
+    auto _call(size_t i, const T& x) -> Result
+    {
+        return this->template _call_impl<Result>(
+            i, x, std::make_index_sequence<N> {});
+    }
+
+    template <typename Result, typename T, size_t... I>
+    auto _call_impl(size_t i, const T& x, std::index_sequence<I...>)
+        -> Result
+    {
+        auto res = Result {};
+        ((i == I ? (res = std::get<I>(this->_oracles)(x), true) : false)
+            || ...);
+        return res;
+    }
+
+    /*!
+     * @brief Sort the checks by increasing cost / probability of violation
+     */
+    void _reorder()
+    {
+        auto score = std::array<double, N> {};
+        for (auto i = 0U; i != N; ++i)
+        {
+            const auto& s = this->_stats[i];
+            const auto p =
+                (double(s.violations) + 1.) / (double(s.calls) + 2.);
+            auto cost = this->weights[i];
+            if (!this->deterministic)
+            { // not reached yet: try it early
+                cost = s.calls == 0 ? 0. : s.seconds / double(s.calls);
+            }
+            score[i] = cost / p;
+        }
+        std::stable_sort(this->_order.begin(), this->_order.end(),
+            [&](size_t i, size_t j) { return score[i] < score[j]; });
+    }
+};
@@ -0,0 +1,245 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <xtensor-blas/xlinalg.hpp>
+#include <xtensor/xarray.hpp>
+
+/*!
+ * @brief Cut pool wrapper around an oracle
+ *
+ *    Keeps the most recent cuts (g, beta) obtained at x0 in a bounded
+ *    ring buffer. A stored cut is affine in x, so at a new center x it is
+ *    re-evaluated in O(n) as
+ *
+ *        beta' = beta + g' (x - x0).
+ *
+ *    If beta' > 0 for some stored cut, x is cut off without calling the
+ *    wrapped oracle (the deepest such cut is returned); otherwise the
+ *    oracle is called and its cut is stored. A parallel cut (g, {beta0,
+ *    beta1}) also cuts x off when beta1' < 0, as (-g, {-beta1', -beta0'}).
+ *
+ *    For cutting_plane_dc(), only the cuts that did not shrink t are
+ *    stored. They must stay valid as t decreases, which is the case when
+ *    t only enters them through f(x) - t.
+ *
+ * @tparam Oracle oracle type (may be a reference type)
+ */
+template <typename Oracle>
+class cut_pool
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+
+    /*!
+     * @brief Stored cut, kept as beta' = g' x + c with c = beta - g' x0
+     */
+    struct entry
+    {
+        Arr g;
+        Arr c; //!< one element for a single cut, two for a parallel cut
+    };
+
+  private:
+    Oracle _Omega;
+    std::vector<entry> _cuts;
+    size_t _capacity;
+    size_t _head = 0; //!< next slot to overwrite once full
+    size_t _hits = 0;
+    size_t _calls = 0;
+
+  public:
+    /*!
+     * @brief Construct a new cut pool object
+     *
+     * @param[in] Omega    the wrapped oracle
+     * @param[in] capacity maximum number of stored cuts
+     */
+    explicit cut_pool(Oracle Omega, size_t capacity = 32)
+        : _Omega {std::forward<Oracle>(Omega)}
+        , _capacity {capacity}
+    {
+        this->_cuts.reserve(capacity);
+    }
+
+    /*!
+     * @brief Feasibility protocol
+     *
+     * @param[in] x
+     * @return std::optional<Cut>
+     */
+    template <typename T>
+    auto operator()(const T& x) -> decltype(std::declval<Oracle&>()(x))
+    {
+        using Cut = typename decltype(this->_Omega(x))::value_type;
+
+        if (auto cut = this->template _screen<Cut>(x))
+        {
+            return cut;
+        }
+        ++this->_calls;
+        auto cut = this->_Omega(x);
+        if (cut)
+        {
+            this->_store(*cut, x);
+        }
+        return cut;
+    }
+
+    /*!
+     * @brief Optimization protocol (cutting_plane_dc)
+     *
+     * @param[in] x
+     * @param[in,out] t the best-so-far optimal value
+     * @return std::tuple<Cut, bool>
+     */
+    template <typename T, typename opt_type>
+    auto operator()(const T& x, opt_type& t)
+        -> decltype(std::declval<Oracle&>()(x, t))
+    {
+        using Cut = std::tuple_element_t<0, decltype(this->_Omega(x, t))>;
+
+        if (auto cut = this->template _screen<Cut>(x))
+        {
+            return {std::move(*cut), false};
+        }
+        ++this->_calls;
+        auto result = this->_Omega(x, t);
+        if (!std::get<1>(result))
+        {
+            this->_store(std::get<0>(result), x);
+        }
+        return result;
+    }
+
+    /*!
+     * @brief Number of cuts served from the pool
+     *
+     * @return size_t
+     */
+    [[nodiscard]] auto hits() const noexcept -> size_t
+    {
+        return this->_hits;
+    }
+
+    /*!
+     * @brief Number of calls to the wrapped oracle
+     *
+     * @return size_t
+     */
+    [[nodiscard]] auto calls() const noexcept -> size_t
+    {
+        return this->_calls;
+    }
+
+    /*!
+     * @brief Forget all stored cuts
+     */
+    void clear()
+    {
+        this->_cuts.clear();
+        this->_head = 0;
+    }
+
+  private:
+    /*!
+     * @brief Deepest stored cut violated at x, re-targeted to x
+     *
+     *    Both sides of a parallel cut are screened: x lies beyond the
+     *    second one when beta1' < 0.
+     *
+     * @tparam Cut
+     * @param[in] x
+     * @return std::optional<Cut>
+     */
+    template <typename Cut, typename T>
+    auto _screen(const T& x) -> std::optional<Cut>
+    {
+        const entry* best = nullptr;
+        auto best_shift = 0.;
+        auto best_beta = 0.;
+        auto best_flip = false; //!< violated on the side of beta1
+        for (const auto& e : this->_cuts)
+        {
+            const auto shift = xt::linalg::dot(e.g, x)();
+            const auto beta = e.c[0] + shift;
+            if (beta > best_beta)
+            {
+                best = &e;
+                best_shift = shift;
+                best_beta = beta;
+                best_flip = false;
+            }
+            if (e.c.size() < 2)
+            {
+                continue;
+            }
+            const auto beta1 = -(e.c[1] + shift);
+            if (beta1 > best_beta)
+            {
+                best = &e;
+                best_shift = shift;
+                best_beta = beta1;
+                best_flip = true;
+            }
+        }
+        if (best == nullptr)
+        {
+            return {};
+        }
+        ++this->_hits;
+        using beta_type = std::tuple_element_t<1, Cut>;
+        if constexpr (std::is_same_v<beta_type, double>)
+        {
+            return Cut {best->g, best_beta};
+        }
+        else
+        {
+            if (best_flip)
+            {
+                return Cut {Arr {-best->g},
+                    Arr {best_beta, -(best->c[0] + best_shift)}};
+            }
+            return Cut {best->g, Arr {best->c + best_shift}};
+        }
+    }
+
+    /*!
+     * @brief Store a cut obtained at x
+     *
+     * @param[in] cut
+     * @param[in] x
+     */
+    template <typename Cut, typename T>
+    void _store(const Cut& cut, const T& x)
+    {
+        if (this->_capacity == 0)
+        {
+            return;
+        }
+        const auto& [g, beta] = cut;
+        const auto gx = xt::linalg::dot(g, x)();
+        auto e = entry {g, {}};
+        if constexpr (std::is_same_v<std::decay_t<decltype(beta)>, double>)
+        {
+            e.c = Arr {beta - gx};
+        }
+        else
+        {
+            e.c = beta - gx;
+        }
+        if (this->_cuts.size() < this->_capacity)
+        {
+            this->_cuts.push_back(std::move(e));
+        }
+        else
+        {
+            this->_cuts[this->_head] = std::move(e);
+            this->_head = (this->_head + 1) % this->_capacity;
+        }
+    }
+};
@@ -0,0 +1,129 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include "ldlt_ext.hpp"
+#include "sparse_matrices.hpp"
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <vector>
+#include <xtensor/xarray.hpp>
+
+/*!
+ * @brief Oracle for large Linear Matrix Inequality, by minimum eigenvector
+ *
+ *    This oracle solves the following feasibility problem:
+ *
+ *        find  x
+ *        s.t.  (B - F * x) >= 0
+ *
+ *    The smallest eigenpair of A = B - F * x is estimated matrix-free by
+ *    restarted Lanczos (full reorthogonalization), warm-started from the
+ *    eigenvector of the previous call. Only products with the nonzeros
+ *    of B and the F_k are needed, O(nnz) each.
+ *
+ *    If the Ritz value is negative, the Ritz vector v (|v| = 1) is a
+ *    certificate, close to the most violated direction: the cut is
+ *    g_k = v' F_k v, ep = -v' A v, deeper than that of the first failing
+ *    pivot of an LDLT. Otherwise, as Lanczos alone cannot certify
+ *    A >= 0, the matrix is factored (see ldlt_ext), which either confirms
+ *    feasibility or gives the usual cut. This factorization is the cost
+ *    of every feasible point; it can be skipped (see set_certification()).
+ */
+class lanczos_lmi_oracle
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+    using Cut = std::tuple<Arr, double>;
+
+  public:
+    using cut_t = Cut; //!< cut buffer type (see cutting_plane_feas)
+
+  private:
+    const size_t _m;
+    const size_t _n;
+    const size_t _krylov_dim;
+    const size_t _max_restarts;
+    const detail::sparse_lower _S; //!< F_0, ..., F_{n-1}, then B
+    Arr _c;                        //!< -x_0, ..., -x_{n-1}, 1
+    Arr _u;                        //!< current eigenvector estimate
+    Arr _V;                        //!< Krylov basis, one vector per row
+    Arr _w;                        //!< scratch
+    Arr _gx;                       //!< scratch: v' F_k v, then v' B v
+    double _theta = 0.;            //!< Ritz value of the last call
+    bool _certify = true;
+    ldlt_ext _Q;
+
+  public:
+    /*!
+     * @brief Construct a new lanczos lmi oracle object
+     *
+     * @param[in] m dimension
+     * @param[in] F
+     * @param[in] B
+     * @param[in] krylov_dim Lanczos steps per restart
+     * @param[in] max_restarts
+     */
+    lanczos_lmi_oracle(size_t m, const std::vector<coo_matrix>& F,
+        const coo_matrix& B, size_t krylov_dim = 24, size_t max_restarts = 8);
+
+    /*!
+     * @brief
+     *
+     * @param[in] x
+     * @return std::optional<Cut>
+     */
+    auto operator()(const Arr& x) -> std::optional<Cut>;
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer
+     *
+     * @param[in] x
+     * @param[out] cut
+     * @return true if x is cut off
+     */
+    auto operator()(const Arr& x, Cut& cut) -> bool;
+
+    /*!
+     * @brief Enable or disable the certification of feasible points (on
+     *        by default)
+     *
+     *    When disabled, a point is taken as feasible as soon as the Ritz
+     *    value is nonnegative, without factoring A. This saves an O(m^3)
+     *    LDLT per feasible point, but a point whose
+     *    negative eigenvalue Lanczos missed is then accepted.
+     *
+     * @param[in] enable
+     */
+    void set_certification(bool enable) noexcept
+    {
+        this->_certify = enable;
+    }
+
+    /*!
+     * @brief Estimate of the smallest eigenvalue of A at the last point
+     *        (an upper bound, being a Rayleigh quotient)
+     *
+     * @return double
+     */
+    [[nodiscard]] auto min_eig() const noexcept -> double
+    {
+        return this->_theta;
+    }
+
+  private:
+    /*!
+     * @brief Lanczos, from _u; leaves the Ritz vector in _u
+     *
+     * @return double Ritz value
+     */
+    auto _lanczos() -> double;
+
+    /*!
+     * @brief The cut of the certificate v over the rows p
+     *
+     * @param[in] v
+     * @param[in] p
+     * @param[out] cut
+     */
+    void _cut(const Arr& v, const std::pair<size_t, size_t>& p, Cut& cut);
+};
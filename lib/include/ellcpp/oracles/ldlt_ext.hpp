@@ -1,8 +1,14 @@
 // -*- coding: utf-8 -*-
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <ellcpp/ell_assert.hpp> // ELL_UNLIKELY
 #include <ellcpp/utility.hpp>
+#include <limits>
+#include <memory>
+#include <vector>
 #include <xtensor/xarray.hpp>
 
 /*!
@@ -13,6 +19,15 @@
  *  - A matrix A in R^{m x m} is positive definite iff v' A v > 0
  *      for all v in R^n.
  *  - O(p^2) per iteration, independent of N
+ *  - D and the strict lower part of L are packed row by row (about
+ *    N^2 / 2 doubles), so that the inner products run over contiguous
+ *    rows and can be vectorized
+ *  - Several factorizations that are used one after another (e.g. the
+ *    sub-oracles of an oracle) may share one workspace. A factorization
+ *    is then valid until another one sharing the workspace is started;
+ *    p and v are not shared.
+ *  - Optionally mixed precision (see factor_mixed()): the elimination runs
+ *    in float, and only the certificate is checked in double.
  */
 class ldlt_ext
 {
@@ -22,30 +37,49 @@ class ldlt_ext
     using Rng = std::pair<size_t, size_t>;
 
   public:
+    using Workspace = std::vector<double>; //!< packed storage of L and D
+
     Rng p {0U, 0U}; //!< the rows where the process starts and stops
     Vec v;        //!< witness vector
 
   private:
-    const size_t n; //!< dimension
-    Mat T;          //!< temporary storage
+    const size_t n;                  //!< dimension
+    std::shared_ptr<Workspace> _ws;  //!< temporary storage
+    std::vector<float> _wsf;         //!< same layout, for factor_mixed()
 
   public:
     /*!
      * @brief Construct a new ldlt ext object
      *
      * @param[in] N dimension
+     * @param[in] ws workspace to share (grown if needed), or a new one
      */
-    explicit ldlt_ext(size_t N)
+    explicit ldlt_ext(size_t N, std::shared_ptr<Workspace> ws = nullptr)
         : v {zeros({N})}
         , n {N}
-        , T {zeros({N, N})}
+        , _ws {ws ? std::move(ws) : std::make_shared<Workspace>()}
     {
+        const auto size = N + N * (N - 1) / 2;
+        if (this->_ws->size() < size)
+        {
+            this->_ws->resize(size);
+        }
     }
 
     ldlt_ext(const ldlt_ext&) = delete;
     ldlt_ext& operator=(const ldlt_ext&) = delete;
     ldlt_ext(ldlt_ext&&) = default;
 
+    /*!
+     * @brief The workspace, to be shared with other factorizations
+     *
+     * @return std::shared_ptr<Workspace>
+     */
+    [[nodiscard]] auto workspace() const -> std::shared_ptr<Workspace>
+    {
+        return this->_ws;
+    }
+
     /*!
      * @brief Perform LDLT Factorization
      *
@@ -74,23 +108,22 @@ class ldlt_ext
     {
         this->p = {0U, 0U};
         auto& [start, stop] = this->p;
+        auto* D = this->_D();
 
         for (auto i = 0U; i != this->n; ++i)
         {
+            auto* Li = this->_L(i);
             // auto j = start;
             auto d = getA(i, start);
             for (auto j = start; j != i; ++j)
             {
-                this->T(j, i) = d;
-                this->T(i, j) = d / this->T(j, j); // note: T(j, i) here!
+                Li[j] = d / D[j];
                 auto s = j + 1;
-                d = getA(i, s);
-                for (auto k = start; k != s; ++k)
-                {
-                    d -= this->T(i, k) * this->T(k, s);
-                }
+                d = getA(i, s)
+                    - _dot(Li + start, this->_L(s) + start, D + start,
+                        s - start);
             }
-            this->T(i, i) = d;
+            D[i] = d;
 
             if constexpr (Allow_semidefinite)
             {
@@ -119,6 +152,72 @@ class ldlt_ext
         return this->is_spd();
     }
 
+    /*!
+     * @brief Perform LDLT Factorization in mixed precision
+     *
+     *    Only the signs of the pivots matter for feasibility, so the
+     *    elimination runs in float (twice the SIMD width, half the memory
+     *    traffic), with the entries of A still evaluated in double. A
+     *    pivot within the rounding band of float, about
+     *    i eps (|a_ii| + sum_j L_ij^2 D_j), is ambiguous: the matrix is
+     *    then factored again in double (see factor()). A clearly negative
+     *    pivot gives a witness v from the float factors, whose quadratic
+     *    form v' A v is recomputed in double: if negative, it replaces the
+     *    pivot, so that witness() and sym_quad() give an exact cut;
+     *    otherwise the matrix is factored again in double.
+     *
+     *    sqrt() is not available after a successful factor_mixed().
+     *
+     * @tparam Callable
+     * @param[in] getA function to access the elements of A (j \le i)
+     * @return true if A is positive definite
+     */
+    template <typename Callable>
+    auto factor_mixed(Callable&& getA) -> bool
+    {
+        constexpr auto eps = std::numeric_limits<float>::epsilon();
+
+        const auto size = this->n + this->n * (this->n - 1) / 2;
+        if (this->_wsf.size() < size)
+        {
+            this->_wsf.resize(size);
+        }
+        this->p = {0U, 0U};
+        auto* D = this->_Df();
+
+        for (auto i = 0U; i != this->n; ++i)
+        {
+            auto* Li = this->_Lf(i);
+            auto a = getA(i, 0);
+            auto d = float(a);
+            for (auto j = 0U; j != i; ++j)
+            {
+                Li[j] = d / D[j];
+                auto s = j + 1;
+                a = getA(i, s);
+                d = float(a) - _dot(Li, this->_Lf(s), D, s);
+            }
+            D[i] = d;
+
+            const auto band = 8.F * float(i + 1) * eps
+                * (std::abs(float(a)) + _dot(Li, Li, D, i));
+            if (d > band)
+            {
+                continue;
+            }
+            if (d >= -band)
+            {
+                return this->factor(getA); // ambiguous
+            }
+            if (this->_certify(getA, i))
+            {
+                return false;
+            }
+            return this->factor(getA);
+        }
+        return true;
+    }
+
 
     /*!
      * @brief Is $A$ symmetric positive definite (spd)
@@ -148,4 +247,110 @@ class ldlt_ext
     auto sym_quad(const Vec& A) const -> double;
 
     auto sqrt() -> Mat;
+
+  private:
+    /*!
+     * @brief D(0), ..., D(N - 1)
+     */
+    auto _D() const noexcept -> double*
+    {
+        return this->_ws->data();
+    }
+
+    /*!
+     * @brief Row i of L: L(i, 0), ..., L(i, i - 1)
+     */
+    auto _L(size_t i) const noexcept -> double*
+    {
+        return this->_ws->data() + this->n + i * (i - 1) / 2;
+    }
+
+    /*!
+     * @brief D(0), ..., D(N - 1), for factor_mixed()
+     */
+    auto _Df() noexcept -> float*
+    {
+        return this->_wsf.data();
+    }
+
+    /*!
+     * @brief Row i of L, for factor_mixed()
+     */
+    auto _Lf(size_t i) noexcept -> float*
+    {
+        return this->_wsf.data() + this->n + i * (i - 1) / 2;
+    }
+
+    /*!
+     * @brief Witness of a negative float pivot at row i, checked in double
+     *
+     * @tparam Callable
+     * @param[in] getA
+     * @param[in] i
+     * @return true if v' A v < 0 (p, v and D(i) are then set)
+     */
+    template <typename Callable>
+    auto _certify(Callable&& getA, size_t i) -> bool
+    {
+        // promote the factors of rows 0..i
+        const auto* wsf = this->_wsf.data();
+        auto* ws = this->_ws->data();
+        std::copy(wsf, wsf + i + 1, ws);
+        std::copy(wsf + this->n, wsf + this->n + i * (i + 1) / 2,
+            ws + this->n);
+        this->p = {0U, i + 1};
+        this->witness();
+
+        auto q = 0.;
+        for (auto r = 0U; r <= i; ++r)
+        {
+            auto s = 0.;
+            for (auto c = 0U; c != r; ++c)
+            {
+                s += getA(r, c) * this->v(c);
+            }
+            q += this->v(r) * (getA(r, r) * this->v(r) + 2. * s);
+        }
+        if (q < 0.)
+        {
+            this->_D()[i] = q;
+            return true;
+        }
+        this->p = {0U, 0U};
+        return false;
+    }
+
+    /*!
+     * @brief sum_k x(k) y(k) d(k), with four independent partial sums
+     *        (vectorizable)
+     *
+     * @tparam T double, or float (see factor_mixed())
+     * @param[in] x
+     * @param[in] y
+     * @param[in] d
+     * @param[in] len
+     * @return T
+     */
+    template <typename T>
+    static auto _dot(const T* x, const T* y, const T* d, size_t len) noexcept
+        -> T
+    {
+        auto s0 = T {};
+        auto s1 = T {};
+        auto s2 = T {};
+        auto s3 = T {};
+        auto k = size_t {0};
+        for (; k + 4 <= len; k += 4)
+        {
+            s0 += x[k] * (y[k] * d[k]);
+            s1 += x[k + 1] * (y[k + 1] * d[k + 1]);
+            s2 += x[k + 2] * (y[k + 2] * d[k + 2]);
+            s3 += x[k + 3] * (y[k + 3] * d[k + 3]);
+        }
+        for (; k != len; ++k)
+        {
+            s0 += x[k] * (y[k] * d[k]);
+        }
+        return (s0 + s1) + (s2 + s3);
+    }
 };
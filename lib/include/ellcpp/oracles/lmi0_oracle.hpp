@@ -3,8 +3,12 @@
 
 //#include "mat.hpp"
 #include "ldlt_ext.hpp"
+#include "pivot_order.hpp"
+#include "stacked_matrices.hpp"
 #include <gsl/span>
+#include <memory>
 #include <optional>
+#include <vector>
 #include <xtensor/xarray.hpp>
 
 /*!
@@ -20,25 +24,64 @@ class lmi0_oracle
     using Arr = xt::xarray<double, xt::layout_type::row_major>;
     using Cut = std::tuple<Arr, double>;
 
+  public:
+    using cut_t = Cut; //!< cut buffer type (see cutting_plane_feas)
+
   private:
-    const gsl::span<const Arr> _F;
+    const Arr _Fc; //!< compiled F (see detail::pack_lower)
     const size_t _n;
+    bool _adaptive = false;
+    bool _mixed = false;
 
   public:
     ldlt_ext _Q;
 
+  private:
+    detail::pivot_order _order;
+
+  public:
+
     /*!
      * @brief Construct a new lmi0 oracle object
      *
      * @param[in] F
+     * @param[in] ws factorization workspace to share (see ldlt_ext)
      */
-    explicit lmi0_oracle(gsl::span<const Arr> F)
-        : _F {F}
+    explicit lmi0_oracle(gsl::span<const Arr> F,
+        std::shared_ptr<ldlt_ext::Workspace> ws = nullptr)
+        : _Fc {detail::pack_lower(F)}
         , _n {F[0].shape()[0]}
-        , _Q(_n)
+        , _Q(_n, std::move(ws))
+        , _order {_n}
     {
     }
 
+    /*!
+     * @brief Enable or disable the adaptive pivot order (off by default)
+     *
+     *    When enabled, the rows where the last factorization failed are
+     *    factored first (see detail::pivot_order), so that nearby
+     *    infeasible points are detected after a few rows. The cuts stay
+     *    exact; evaluate_batch() keeps the natural order.
+     *
+     * @param[in] enable
+     */
+    void set_adaptive_pivoting(bool enable) noexcept
+    {
+        this->_adaptive = enable;
+    }
+
+    /*!
+     * @brief Enable or disable the mixed-precision factorization (off by
+     *        default; see ldlt_ext::factor_mixed())
+     *
+     * @param[in] enable
+     */
+    void set_mixed_precision(bool enable) noexcept
+    {
+        this->_mixed = enable;
+    }
+
     /*!
      * @brief
      *
@@ -46,4 +89,25 @@ class lmi0_oracle
      * @return std::optional<Cut>
      */
     auto operator()(const Arr& x) -> std::optional<Cut>;
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer (no allocation)
+     *
+     * @param[in] x
+     * @param[out] cut
+     * @return true if x is cut off
+     */
+    auto operator()(const Arr& x, Cut& cut) -> bool;
+
+    /*!
+     * @brief Assess several points at once
+     *
+     *    The matrices of all the points are assembled with one
+     *    matrix-matrix product over the stacked F, then factored in turn
+     *    in the same workspace.
+     *
+     * @param[in] X points, one per row
+     * @return std::vector<std::optional<Cut>> one result per point
+     */
+    auto evaluate_batch(const Arr& X) -> std::vector<std::optional<Cut>>;
 };
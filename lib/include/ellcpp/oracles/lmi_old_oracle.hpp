@@ -19,9 +19,13 @@ class lmi_old_oracle
     using Arr = xt::xarray<double, xt::layout_type::row_major>;
     using Cut = std::tuple<Arr, double>;
 
+  public:
+    using cut_t = Cut; //!< cut buffer type (see cutting_plane_feas)
+
   private:
     const gsl::span<const Arr> _F;
     const Arr _F0;
+    Arr _A; //!< scratch for B - F * x
     ldlt_ext _Q;
 
   public:
@@ -34,6 +38,7 @@ class lmi_old_oracle
     lmi_old_oracle(gsl::span<const Arr> F, Arr B)
         : _F {F}
         , _F0 {std::move(B)}
+        , _A {this->_F0}
         , _Q {this->_F0.shape()[0]}
     {
     }
@@ -45,4 +50,13 @@ class lmi_old_oracle
      * @return std::optional<Cut>
      */
     auto operator()(const Arr& x) -> std::optional<Cut>;
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer (no allocation)
+     *
+     * @param[in] x
+     * @param[out] cut
+     * @return true if x is cut off
+     */
+    auto operator()(const Arr& x, Cut& cut) -> bool;
 };
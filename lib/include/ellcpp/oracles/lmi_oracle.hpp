@@ -2,8 +2,13 @@
 #pragma once
 
 #include "ldlt_ext.hpp"
+#include "low_rank_matrices.hpp"
+#include "pivot_order.hpp"
+#include "stacked_matrices.hpp"
 #include <gsl/span>
+#include <memory>
 #include <optional>
+#include <vector>
 #include <xtensor/xarray.hpp>
 
 /*!
@@ -13,16 +18,29 @@
  *
  *        find  x
  *        s.t.  (B - F * x) >= 0
+ *
+ *    The F_k may be given densely, or in low-rank form (U_k V_k' + V_k U_k')
+ *    / 2 (see low_rank_matrix), whose assembly costs O(m^2 r_k) instead of
+ *    O(m^2) memory per term, and whose gradient component costs O(p r_k)
+ *    instead of O(p^2). Both forms can be mixed: x holds the coefficients
+ *    of the dense F_k first, then those of the low-rank ones.
  */
 class lmi_oracle
 {
     using Arr = xt::xarray<double, xt::layout_type::row_major>;
     using Cut = std::tuple<Arr, double>;
 
+  public:
+    using cut_t = Cut; //!< cut buffer type (see cutting_plane_feas)
+
   private:
-    const gsl::span<const Arr> _F;
+    const Arr _Fc; //!< compiled F (see detail::pack_lower)
     const Arr _F0;
+    detail::low_rank_terms _L;
     ldlt_ext _Q;
+    detail::pivot_order _order;
+    bool _adaptive = false;
+    bool _mixed = false;
 
   public:
     /*!
@@ -30,12 +48,56 @@ class lmi_oracle
      *
      * @param[in] F
      * @param[in] B
+     * @param[in] ws factorization workspace to share (see ldlt_ext)
      */
-    lmi_oracle(gsl::span<const Arr> F, Arr B)
-        : _F {F}
+    lmi_oracle(gsl::span<const Arr> F, Arr B,
+        std::shared_ptr<ldlt_ext::Workspace> ws = nullptr)
+        : lmi_oracle(F, {}, std::move(B), std::move(ws))
+    {
+    }
+
+    /*!
+     * @brief Construct a new lmi oracle object with low-rank terms
+     *
+     * @param[in] F dense terms
+     * @param[in] L low-rank terms, after the dense ones in x
+     * @param[in] B
+     * @param[in] ws factorization workspace to share (see ldlt_ext)
+     */
+    lmi_oracle(gsl::span<const Arr> F, gsl::span<const low_rank_matrix> L,
+        Arr B, std::shared_ptr<ldlt_ext::Workspace> ws = nullptr)
+        : _Fc {detail::pack_lower(F)}
         , _F0 {std::move(B)}
-        , _Q {this->_F0.shape()[0]}
+        , _L {this->_F0.shape()[0], L}
+        , _Q {this->_F0.shape()[0], std::move(ws)}
+        , _order {this->_F0.shape()[0]}
+    {
+    }
+
+    /*!
+     * @brief Enable or disable the adaptive pivot order (off by default)
+     *
+     *    When enabled, the rows where the last factorization failed are
+     *    factored first (see detail::pivot_order), so that nearby
+     *    infeasible points are detected after a few rows. The cuts stay
+     *    exact; evaluate_batch() keeps the natural order.
+     *
+     * @param[in] enable
+     */
+    void set_adaptive_pivoting(bool enable) noexcept
     {
+        this->_adaptive = enable;
+    }
+
+    /*!
+     * @brief Enable or disable the mixed-precision factorization (off by
+     *        default; see ldlt_ext::factor_mixed())
+     *
+     * @param[in] enable
+     */
+    void set_mixed_precision(bool enable) noexcept
+    {
+        this->_mixed = enable;
     }
 
     /*!
@@ -45,4 +107,26 @@ class lmi_oracle
      * @return std::optional<Cut>
      */
     auto operator()(const Arr& x) -> std::optional<Cut>;
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer (no allocation)
+     *
+     * @param[in] x
+     * @param[out] cut
+     * @return true if x is cut off
+     */
+    auto operator()(const Arr& x, Cut& cut) -> bool;
+
+    /*!
+     * @brief Assess several points at once
+     *
+     *    The matrices of all the points are assembled with one
+     *    matrix-matrix product over the stacked F, then factored in turn
+     *    in the same workspace. With low-rank terms, the points are
+     *    assessed one by one.
+     *
+     * @param[in] X points, one per row
+     * @return std::vector<std::optional<Cut>> one result per point
+     */
+    auto evaluate_batch(const Arr& X) -> std::vector<std::optional<Cut>>;
 };
@@ -0,0 +1,190 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <gsl/span>
+#include <utility>
+#include <vector>
+#include <xtensor/xarray.hpp>
+
+/*!
+ * @brief Low-rank symmetric matrix (U V' + V U') / 2
+ *
+ *    U and V are m x r. For a rank-one u u', take U = V = u (m x 1).
+ */
+struct low_rank_matrix
+{
+    xt::xarray<double, xt::layout_type::row_major> U;
+    xt::xarray<double, xt::layout_type::row_major> V;
+};
+
+namespace detail
+{
+
+/*!
+ * @brief Compiled low-rank F_k: the U and V of all the terms side by side
+ *
+ *    Column c of U and V belongs to the term _term[c]. For a point x, U
+ *    is scaled column-wise by x (see scale()), so that
+ *
+ *        sum_k x_k F_k(i, j) = (Ux(i, :) V(j, :)' + V(i, :) Ux(j, :)') / 2
+ *
+ *    is two contiguous dot products of length R = sum_k r_k.
+ */
+class low_rank_terms
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+
+  private:
+    size_t _R = 0;
+    Arr _U;
+    Arr _V;
+    Arr _Ux; //!< U scaled by x
+    Arr _a;  //!< scratch: U' v
+    Arr _b;  //!< scratch: V' v
+    std::vector<size_t> _term;
+
+  public:
+    /*!
+     * @brief Construct a new low rank terms object
+     *
+     * @param[in] m dimension
+     * @param[in] L
+     */
+    low_rank_terms(size_t m, gsl::span<const low_rank_matrix> L)
+    {
+        for (auto k = 0U; k != L.size(); ++k)
+        {
+            this->_term.insert(this->_term.end(), L[k].U.shape()[1], k);
+        }
+        this->_R = this->_term.size();
+        this->_U = xt::zeros<double>({m, this->_R});
+        this->_V = xt::zeros<double>({m, this->_R});
+        auto c0 = size_t {0};
+        for (const auto& Lk : L)
+        {
+            for (auto i = 0U; i != m; ++i)
+            {
+                for (auto r = 0U; r != Lk.U.shape()[1]; ++r)
+                {
+                    this->_U(i, c0 + r) = Lk.U(i, r);
+                    this->_V(i, c0 + r) = Lk.V(i, r);
+                }
+            }
+            c0 += Lk.U.shape()[1];
+        }
+        this->_Ux = this->_U;
+        this->_a = xt::zeros<double>({this->_R});
+        this->_b = xt::zeros<double>({this->_R});
+    }
+
+    /*!
+     * @brief No low-rank term?
+     */
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return this->_R == 0;
+    }
+
+    /*!
+     * @brief Set the point, O(m R)
+     *
+     * @param[in] x coefficients of the terms
+     */
+    void scale(const double* x)
+    {
+        const auto* u = this->_U.data();
+        auto* ux = this->_Ux.data();
+        const auto m = this->_U.shape()[0];
+        for (auto i = 0U; i != m; ++i)
+        {
+            for (auto c = 0U; c != this->_R; ++c)
+            {
+                *ux++ = *u++ * x[this->_term[c]];
+            }
+        }
+    }
+
+    /*!
+     * @brief sum_k x_k F_k(i, j), at the point of the last scale()
+     *
+     * @param[in] i
+     * @param[in] j
+     * @return double
+     */
+    [[nodiscard]] auto entry(size_t i, size_t j) const -> double
+    {
+        const auto* ui = this->_Ux.data() + i * this->_R;
+        const auto* uj = this->_Ux.data() + j * this->_R;
+        const auto* vi = this->_V.data() + i * this->_R;
+        const auto* vj = this->_V.data() + j * this->_R;
+        auto res = 0.;
+        for (auto c = 0U; c != this->_R; ++c)
+        {
+            res += ui[c] * vj[c] + vi[c] * uj[c];
+        }
+        return res / 2.;
+    }
+
+    /*!
+     * @brief g_k += s * v' F_k(p, p) v = s * (U_k' v) . (V_k' v), O(|p| R)
+     *
+     * @param[in] v witness vector
+     * @param[in] p rows [start, stop) of the witness
+     * @param[in] s scale factor
+     * @param[in,out] g
+     */
+    void sym_quad(const Arr& v, const std::pair<size_t, size_t>& p, double s,
+        double* g)
+    {
+        const auto [start, stop] = p;
+        this->_sym_quad(
+            stop - start, [start = start](size_t a) { return start + a; },
+            [&v, start = start](size_t a) { return v(start + a); }, s, g);
+    }
+
+    /*!
+     * @brief Same as above, for a witness of a permuted matrix (see
+     *        pivot_order)
+     *
+     * @param[in] rows rows of the witness, in any order
+     * @param[in] w w[a] is the entry of rows[a]
+     * @param[in] s scale factor
+     * @param[in,out] g
+     */
+    void sym_quad(
+        const std::vector<size_t>& rows, const double* w, double s, double* g)
+    {
+        this->_sym_quad(
+            rows.size(), [&rows](size_t a) { return rows[a]; },
+            [w](size_t a) { return w[a]; }, s, g);
+    }
+
+  private:
+    template <typename Row, typename Val>
+    void _sym_quad(size_t len, Row&& row, Val&& val, double s, double* g)
+    {
+        auto* a = this->_a.data();
+        auto* b = this->_b.data();
+        std::fill(a, a + this->_R, 0.);
+        std::fill(b, b + this->_R, 0.);
+        for (auto t = 0U; t != len; ++t)
+        {
+            const auto* ui = this->_U.data() + row(t) * this->_R;
+            const auto* vi = this->_V.data() + row(t) * this->_R;
+            const auto wt = val(t);
+            for (auto c = 0U; c != this->_R; ++c)
+            {
+                a[c] += ui[c] * wt;
+                b[c] += vi[c] * wt;
+            }
+        }
+        for (auto c = 0U; c != this->_R; ++c)
+        {
+            g[this->_term[c]] += s * a[c] * b[c];
+        }
+    }
+};
+
+} // namespace detail
@@ -1,6 +1,7 @@
 // -*- coding: utf-8 -*-
 #pragma once
 
+#include <ellcpp/cut_generator.hpp>
 #include <limits>
 #include <xtensor/xarray.hpp>
 
@@ -20,11 +21,15 @@ class lowpass_oracle
     using Arr = xt::xarray<double, xt::layout_type::row_major>;
     using ParallelCut = std::tuple<Arr, Arr>;
 
+  public:
+    using cut_t = ParallelCut; //!< cut buffer type (see cutting_plane_dc)
+
   private:
     mutable size_t _i_Anr {};
     mutable size_t _i_As {};
     mutable size_t _i_Ap {};
     // mutable unsigned int _count{};
+    cut_stack _stack {};
 
     const Arr& _Ap;
     const Arr& _As;
@@ -61,4 +66,39 @@ class lowpass_oracle
      */
     auto operator()(const Arr& x, double& Spsq) const
         -> std::tuple<ParallelCut, bool>;
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer (no allocation)
+     *
+     * The buffer always holds two betas; a single cut has beta1 = +inf,
+     * which the search spaces treat as no second cut.
+     *
+     * @param[in] x
+     * @param[in,out] Spsq
+     * @param[out] cut
+     * @return true if Spsq is shrunk
+     */
+    auto operator()(const Arr& x, double& Spsq, ParallelCut& cut) const
+        -> bool;
+
+    /*!
+     * @brief Lazily yield the violated constraints at x
+     *
+     * Same as operator() but every violated constraint is yielded in
+     * turn, so that a driver may pick a deeper one. The objective cut is
+     * yielded only if no constraint is violated. The round-robin position
+     * is left as it is, so that the next call does not depend on how many
+     * cuts the driver pulled.
+     *
+     * @param[in] x (must outlive the generator)
+     * @param[in] Spsq
+     * @return cut_generator<std::tuple<ParallelCut, bool>>
+     */
+    auto generate(const Arr& x, double& Spsq) const
+        -> cut_generator<std::tuple<ParallelCut, bool>>;
+
+  private:
+    template <typename Emit>
+    auto _assess(const Arr& x, double& Spsq, ParallelCut& cut,
+        Emit&& emit) const -> bool;
 };
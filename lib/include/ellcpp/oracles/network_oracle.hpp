@@ -4,6 +4,9 @@
 #include <ellcpp/utility.hpp>
 #include <netoptim/neg_cycle.hpp> // import negCycleFinder
 #include <optional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 /*!
  * @brief Oracle for Parametric Network Problem.
@@ -28,6 +31,7 @@ class network_oracle
     Container& _u; // reference???
     negCycleFinder<Graph> _S;
     Fn _h;
+    std::vector<edge_t> _C; //!< the last negative cycle
 
   public:
     /*!
@@ -74,23 +78,61 @@ class network_oracle
      */
     template <typename T>
     auto operator()(const T& x) -> std::optional<std::tuple<T, double>>
+    {
+        auto cut = std::tuple<T, double> {};
+        if (!(*this)(x, cut))
+        {
+            return {};
+        }
+        return {std::move(cut)};
+    }
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer
+     *
+     *    The gradient and the cycle reuse their storage. For a vector x,
+     *    h.grad(e, x) should return a reference, not a new vector.
+     *
+     * @tparam T
+     * @param[in] x
+     * @param[out] cut
+     * @return true if x is cut off
+     */
+    template <typename T>
+    auto operator()(const T& x, std::tuple<T, double>& cut) -> bool
     {
         auto get_weight = [this, &x](const edge_t& e) -> double
         { return this->_h.eval(e, x); };
 
-        auto C = this->_S.find_neg_cycle(this->_u, get_weight);
-        if (C.empty())
+        if (!this->_S.find_neg_cycle(this->_u, get_weight, this->_C))
         {
-            return {};
+            return false;
         }
 
-        auto g = zeros(x);
-        auto f = 0.;
-        for (auto&& e : C)
+        auto& [g, f] = cut;
+        f = 0.;
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            g = 0.;
+            for (auto&& e : this->_C)
+            {
+                f -= this->_h.eval(e, x);
+                g -= this->_h.grad(e, x);
+            }
+        }
+        else
         {
-            f -= this->_h.eval(e, x);
-            g -= this->_h.grad(e, x);
+            fill_zeros(g, x.size());
+            for (auto&& e : this->_C)
+            {
+                f -= this->_h.eval(e, x);
+                const auto& ge = this->_h.grad(e, x);
+                for (auto i = 0U; i != g.size(); ++i)
+                {
+                    g(i) -= ge(i);
+                }
+            }
         }
-        return {{std::move(g), f}};
+        return true;
     }
 };
@@ -35,6 +35,8 @@ class optscaling_oracle
       private:
         const Graph& _G;
         Fn _get_cost;
+        Arr _g_pi {1., 0.};   //!< gradient of x(0) - cost
+        Arr _g_phi {0., -1.}; //!< gradient of cost - x(1)
 
       public:
         /*!
@@ -75,19 +77,21 @@ class optscaling_oracle
          *
          * @param[in] e
          * @param[in] x (\pi, \phi) in log scale
-         * @return Arr
+         * @return const Arr&
          */
-        auto grad(const edge_t& e, const Arr& x) const -> Arr
+        auto grad(const edge_t& e, const Arr& /* x */) const -> const Arr&
         {
             const auto [u, v] = this->_G.end_points(e);
             assert(u != v);
-            return (u < v) ? Arr {1., 0.} : Arr {0., -1.};
+            return (u < v) ? this->_g_pi : this->_g_phi;
         }
     };
 
     network_oracle<Graph, Container, Ratio> _network;
 
   public:
+    using cut_t = Cut; //!< cut buffer type (see cutting_plane_dc)
+
     /*!
      * @brief Construct a new optscaling oracle object
      *
@@ -120,18 +124,39 @@ class optscaling_oracle
      */
     auto operator()(const Arr& x, double& t) -> std::tuple<Cut, bool>
     {
-        const auto cut = this->_network(x);
-        if (cut)
+        auto cut = Cut {};
+        const auto shrunk = (*this)(x, t, cut);
+        return {std::move(cut), shrunk};
+    }
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer
+     *
+     * @param[in] x (\pi, \phi) in log scale
+     * @param[in,out] t the best-so-far optimal value
+     * @param[out] cut
+     * @return true if t is shrunk
+     *
+     * @see cutting_plane_dc
+     */
+    auto operator()(const Arr& x, double& t, Cut& cut) -> bool
+    {
+        if (this->_network(x, cut))
         {
-            return {*cut, false};
+            return false;
         }
-        auto s = x(0) - x(1);
-        auto fj = s - t;
+        auto& [g, fj] = cut;
+        fill_zeros(g, 2);
+        g(0) = 1.;
+        g(1) = -1.;
+        const auto s = x(0) - x(1);
+        fj = s - t;
         if (fj < 0)
         {
             t = s;
-            return {{Arr {1., -1.}, 0.}, true};
+            fj = 0.;
+            return true;
         }
-        return {{Arr {1., -1.}, fj}, false};
+        return false;
     }
 };
@@ -0,0 +1,107 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include <xtensor/xarray.hpp>
+
+namespace detail
+{
+
+/*!
+ * @brief Symmetric pivot order of an LMI that puts the recently failing
+ *        rows first
+ *
+ *    The matrix is factored as P A P', row i of the factorization being
+ *    row perm[i] of A. When it fails, with witness v over the rows
+ *    [start, stop) of P A P', the failing pivot is moved to the front,
+ *    followed by the other rows of the witness by decreasing |v_i|. The
+ *    next points of a cutting-plane run are close by, so that they are
+ *    likely to fail within the first few rows.
+ *
+ *    Any order gives a valid certificate: with u = P' v,
+ *    u' A u = v' (P A P') v < 0.
+ */
+class pivot_order
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+
+  private:
+    std::vector<size_t> _perm;
+    std::vector<size_t> _rows; //!< rows of A of the last witness
+    std::vector<size_t> _idx;  //!< scratch
+
+  public:
+    /*!
+     * @brief Construct a new pivot order object (identity)
+     *
+     * @param[in] m dimension
+     */
+    explicit pivot_order(size_t m)
+        : _perm(m)
+    {
+        std::iota(this->_perm.begin(), this->_perm.end(), 0U);
+    }
+
+    /*!
+     * @brief Row of A at position i of the factorization
+     *
+     * @param[in] i
+     * @return size_t
+     */
+    auto operator[](size_t i) const noexcept -> size_t
+    {
+        return this->_perm[i];
+    }
+
+    /*!
+     * @brief Record a failure and reorder
+     *
+     * @param[in] v witness vector of P A P'
+     * @param[in] p rows [start, stop) of the witness
+     */
+    void update(const Arr& v, const std::pair<size_t, size_t>& p)
+    {
+        const auto [start, stop] = p;
+        this->_rows.assign(
+            this->_perm.begin() + start, this->_perm.begin() + stop);
+
+        // positions of the witness: the failing pivot first, then by |v|
+        this->_idx.resize(stop - start);
+        std::iota(this->_idx.begin(), this->_idx.end(), start);
+        std::stable_sort(this->_idx.begin(), this->_idx.end() - 1,
+            [&v](size_t a, size_t b) {
+                return std::abs(v(a)) > std::abs(v(b));
+            });
+        std::rotate(
+            this->_idx.begin(), this->_idx.end() - 1, this->_idx.end());
+        for (auto& i : this->_idx)
+        {
+            i = this->_perm[i];
+        }
+
+        // then the other rows, in their previous order
+        std::copy(this->_perm.begin(), this->_perm.begin() + start,
+            std::back_inserter(this->_idx));
+        std::copy(this->_perm.begin() + stop, this->_perm.end(),
+            std::back_inserter(this->_idx));
+        this->_perm.swap(this->_idx);
+    }
+
+    /*!
+     * @brief Rows of A of the last witness, in the order of v
+     *
+     * @return const std::vector<size_t>&
+     */
+    [[nodiscard]] auto rows() const noexcept -> const std::vector<size_t>&
+    {
+        return this->_rows;
+    }
+};
+
+} // namespace detail
@@ -28,6 +28,9 @@ class profit_oracle
     using Arr = xt::xarray<double, xt::layout_type::row_major>;
     using Cut = std::tuple<Arr, double>;
 
+  public:
+    using cut_t = Cut; //!< cut buffer type (see cutting_plane_dc)
+
   private:
     const double _log_pA;
     const double _log_k;
@@ -68,6 +71,16 @@ class profit_oracle
      * @return std::tuple<Cut, double> Cut and the updated best-so-far value
      */
     auto operator()(const Arr& y, double& t) const -> std::tuple<Cut, bool>;
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer (no allocation)
+     *
+     * @param[in] y input quantity (in log scale)
+     * @param[in,out] t the best-so-far optimal value
+     * @param[out] cut
+     * @return true if t is shrunk
+     */
+    auto operator()(const Arr& y, double& t, Cut& cut) const -> bool;
 };
 
 /*!
@@ -160,6 +173,9 @@ class profit_q_oracle
     using Arr = xt::xarray<double, xt::layout_type::row_major>;
     using Cut = std::tuple<Arr, double>;
 
+  public:
+    using cut_t = Cut; //!< cut buffer type (see cutting_plane_q)
+
   private:
     profit_oracle _P;
     Arr _yd;
@@ -179,6 +195,16 @@ class profit_q_oracle
     {
     }
 
+    /*!
+     * @brief Round y to the discrete point to be assessed
+     *
+     * @param[in] y input quantity (in log scale)
+     * @return const Arr& the discrete point (in log scale)
+     *
+     * @see cutting_plane_q
+     */
+    auto discretize(const Arr& y) -> const Arr&;
+
     /*!
      * @brief Make object callable for cutting_plane_q()
      *
@@ -190,4 +216,17 @@ class profit_q_oracle
      */
     auto operator()(const Arr& y, double& t, bool retry)
         -> std::tuple<Cut, Arr, bool, bool>;
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer (no allocation)
+     *
+     * @param[in] y input quantity (in log scale)
+     * @param[in,out] t the best-so-far optimal value
+     * @param[in] retry
+     * @param[out] cut
+     * @return the discrete point (valid until the next call), whether t
+     *         is shrunk, and whether another cut can be tried
+     */
+    auto operator()(const Arr& y, double& t, bool retry, Cut& cut)
+        -> std::tuple<const Arr&, bool, bool>;
 };
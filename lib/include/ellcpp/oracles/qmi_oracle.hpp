@@ -2,8 +2,11 @@
 #pragma once
 
 #include "ldlt_ext.hpp"
+#include "stacked_matrices.hpp"
 #include <gsl/span>
+#include <memory>
 #include <optional>
+#include <vector>
 #include <xtensor/xarray.hpp>
 
 /*!
@@ -23,6 +26,9 @@ class qmi_oracle
     using Arr = xt::xarray<double, xt::layout_type::row_major>;
     using Cut = std::tuple<Arr, double>;
 
+  public:
+    using cut_t = Cut; //!< cut buffer type (see cutting_plane_feas)
+
   private:
     double _t = 0.;
     size_t _nx = 0;
@@ -33,6 +39,8 @@ class qmi_oracle
     const gsl::span<const Arr> _F;
     const Arr _F0;
     Arr _Fx;
+    Arr _Av; //!< scratch: v' F(x) over the rows of the witness
+    Arr _Fs; //!< stacked F', built on the first batch
 
   public:
     ldlt_ext _Q;
@@ -43,14 +51,17 @@ class qmi_oracle
      *
      * @param[in] F
      * @param[in] F0
+     * @param[in] ws factorization workspace to share (see ldlt_ext)
      */
-    qmi_oracle(gsl::span<const Arr> F, Arr F0)
+    qmi_oracle(gsl::span<const Arr> F, Arr F0,
+        std::shared_ptr<ldlt_ext::Workspace> ws = nullptr)
         : _n {F0.shape()[0]}
         , _m {F0.shape()[1]}
         , _F {F}
         , _F0 {std::move(F0)}
         , _Fx {zeros({_m, _n})} // transposed
-        , _Q(_m)                // take column
+        , _Av {zeros({_n})}
+        , _Q(_m, std::move(ws)) // take column
     {
     }
 
@@ -71,4 +82,43 @@ class qmi_oracle
      * @return std::optional<Cut>
      */
     auto operator()(const Arr& x) -> std::optional<Cut>;
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer (no allocation)
+     *
+     * @param[in] x
+     * @param[out] cut
+     * @return true if x is cut off
+     */
+    auto operator()(const Arr& x, Cut& cut) -> bool;
+
+    /*!
+     * @brief Assess several points at once
+     *
+     *    F(x) of all the points is assembled with one matrix-matrix
+     *    product over the stacked F, then each point is factored in turn
+     *    in the same workspace.
+     *
+     * @param[in] X points, one per row
+     * @return std::vector<std::optional<Cut>> one result per point
+     */
+    auto evaluate_batch(const Arr& X) -> std::vector<std::optional<Cut>>;
+
+  private:
+    /*!
+     * @brief Factor t * I - F(x)' F(x), with the rows of _Fx built so far
+     *
+     * @param[in] x
+     * @param[out] cut
+     * @return true if x is cut off
+     */
+    auto _assess(const Arr& x, Cut& cut) -> bool;
+
+    /*!
+     * @brief Form row i of _Fx, i.e. column i of F(x)
+     *
+     * @param[in] x
+     * @param[in] i
+     */
+    void _form_row(const Arr& x, size_t i);
 };
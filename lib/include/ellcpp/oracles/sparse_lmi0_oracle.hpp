@@ -0,0 +1,67 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include "ldlt_ext.hpp"
+#include "sparse_matrices.hpp"
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+#include <xtensor/xarray.hpp>
+
+/*!
+ * @brief Oracle for Linear Matrix Inequality, with sparse F_k
+ *
+ *    This oracle solves the following feasibility problem:
+ *
+ *        find  x
+ *        s.t.  F * x >= 0
+ *
+ *    Same as lmi0_oracle, except that each F_k is given by its nonzeros
+ *    (see coo_matrix).
+ */
+class sparse_lmi0_oracle
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+    using Cut = std::tuple<Arr, double>;
+
+  public:
+    using cut_t = Cut; //!< cut buffer type (see cutting_plane_feas)
+
+  private:
+    const detail::sparse_lower _F;
+
+  public:
+    ldlt_ext _Q;
+
+    /*!
+     * @brief Construct a new sparse lmi0 oracle object
+     *
+     * @param[in] m dimension of the F_k
+     * @param[in] F
+     * @param[in] ws factorization workspace to share (see ldlt_ext)
+     */
+    sparse_lmi0_oracle(size_t m, const std::vector<coo_matrix>& F,
+        std::shared_ptr<ldlt_ext::Workspace> ws = nullptr)
+        : _F {m, F}
+        , _Q(m, std::move(ws))
+    {
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] x
+     * @return std::optional<Cut>
+     */
+    auto operator()(const Arr& x) -> std::optional<Cut>;
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer (no allocation)
+     *
+     * @param[in] x
+     * @param[out] cut
+     * @return true if x is cut off
+     */
+    auto operator()(const Arr& x, Cut& cut) -> bool;
+};
@@ -0,0 +1,69 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include "ldlt_ext.hpp"
+#include "sparse_matrices.hpp"
+#include <optional>
+#include <tuple>
+#include <vector>
+#include <xtensor/xarray.hpp>
+
+/*!
+ * @brief Oracle for Linear Matrix Inequality, with sparse F_k
+ *
+ *    This oracle solves the following feasibility problem:
+ *
+ *        find  x
+ *        s.t.  (B - F * x) >= 0
+ *
+ *    Same as lmi_old_oracle, except that each F_k is given by its
+ *    nonzeros (see coo_matrix). B - F * x is still formed and factored
+ *    as a whole, but the assembly and the gradient only touch the
+ *    nonzeros of the F_k.
+ */
+class sparse_lmi_old_oracle
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+    using Cut = std::tuple<Arr, double>;
+
+  public:
+    using cut_t = Cut; //!< cut buffer type (see cutting_plane_feas)
+
+  private:
+    const detail::sparse_lower _F;
+    const Arr _F0;
+    Arr _A; //!< scratch for B - F * x
+    ldlt_ext _Q;
+
+  public:
+    /*!
+     * @brief Construct a new sparse lmi old oracle object
+     *
+     * @param[in] F
+     * @param[in] B
+     */
+    sparse_lmi_old_oracle(const std::vector<coo_matrix>& F, Arr B)
+        : _F {B.shape()[0], F}
+        , _F0 {std::move(B)}
+        , _A {this->_F0}
+        , _Q {this->_F0.shape()[0]}
+    {
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] x
+     * @return std::optional<Cut>
+     */
+    auto operator()(const Arr& x) -> std::optional<Cut>;
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer (no allocation)
+     *
+     * @param[in] x
+     * @param[out] cut
+     * @return true if x is cut off
+     */
+    auto operator()(const Arr& x, Cut& cut) -> bool;
+};
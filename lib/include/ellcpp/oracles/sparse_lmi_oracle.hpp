@@ -0,0 +1,68 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include "ldlt_ext.hpp"
+#include "sparse_matrices.hpp"
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+#include <xtensor/xarray.hpp>
+
+/*!
+ * @brief Oracle for Linear Matrix Inequality, with sparse F_k
+ *
+ *    This oracle solves the following feasibility problem:
+ *
+ *        find  x
+ *        s.t.  (B - F * x) >= 0
+ *
+ *    Same as lmi_oracle, except that each F_k is given by its nonzeros
+ *    (see coo_matrix). Assembly and gradients only touch the nonzeros.
+ */
+class sparse_lmi_oracle
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+    using Cut = std::tuple<Arr, double>;
+
+  public:
+    using cut_t = Cut; //!< cut buffer type (see cutting_plane_feas)
+
+  private:
+    const detail::sparse_lower _F;
+    const Arr _F0;
+    ldlt_ext _Q;
+
+  public:
+    /*!
+     * @brief Construct a new sparse lmi oracle object
+     *
+     * @param[in] F
+     * @param[in] B
+     * @param[in] ws factorization workspace to share (see ldlt_ext)
+     */
+    sparse_lmi_oracle(const std::vector<coo_matrix>& F, Arr B,
+        std::shared_ptr<ldlt_ext::Workspace> ws = nullptr)
+        : _F {B.shape()[0], F}
+        , _F0 {std::move(B)}
+        , _Q {this->_F0.shape()[0], std::move(ws)}
+    {
+    }
+
+    /*!
+     * @brief
+     *
+     * @param[in] x
+     * @return std::optional<Cut>
+     */
+    auto operator()(const Arr& x) -> std::optional<Cut>;
+
+    /*!
+     * @brief Same as above, writing the cut into a buffer (no allocation)
+     *
+     * @param[in] x
+     * @param[out] cut
+     * @return true if x is cut off
+     */
+    auto operator()(const Arr& x, Cut& cut) -> bool;
+};
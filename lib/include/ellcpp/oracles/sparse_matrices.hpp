@@ -0,0 +1,197 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include <xtensor/xarray.hpp>
+
+/*!
+ * @brief Sparse symmetric matrix in coordinate (COO) format
+ *
+ *    Each nonzero is given once, from either triangle: (i, j) and (j, i)
+ *    denote the same entry. Repeated entries are summed.
+ */
+struct coo_matrix
+{
+    std::vector<size_t> row;
+    std::vector<size_t> col;
+    std::vector<double> val;
+};
+
+namespace detail
+{
+
+/*!
+ * @brief Compiled sparse F_k: lower triangle, row by row (CSR)
+ *
+ *    Row i lists the nonzeros (j, k, F_k(i, j)), j \le i, of all the F_k
+ *    together, sorted by j. Memory is O(m + nnz), independent of n.
+ */
+class sparse_lower
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+
+  private:
+    std::vector<size_t> _ptr; //!< row i is [_ptr[i], _ptr[i + 1])
+    std::vector<size_t> _col; //!< j
+    std::vector<size_t> _var; //!< k
+    std::vector<double> _val; //!< F_k(i, j)
+
+  public:
+    /*!
+     * @brief Construct a new sparse lower object
+     *
+     * @param[in] m dimension of the F_k
+     * @param[in] F
+     */
+    sparse_lower(size_t m, const std::vector<coo_matrix>& F)
+    {
+        struct nonzero
+        {
+            size_t i;
+            size_t j;
+            size_t k;
+            double a;
+        };
+
+        auto nzs = std::vector<nonzero> {};
+        for (auto k = 0U; k != F.size(); ++k)
+        {
+            const auto& Fk = F[k];
+            for (auto t = 0U; t != Fk.val.size(); ++t)
+            {
+                const auto [j, i] = std::minmax(Fk.row[t], Fk.col[t]);
+                assert(i < m);
+                nzs.push_back({i, j, k, Fk.val[t]});
+            }
+        }
+        std::sort(nzs.begin(), nzs.end(), [](const auto& a, const auto& b) {
+            return std::tie(a.i, a.j, a.k) < std::tie(b.i, b.j, b.k);
+        });
+
+        this->_ptr.assign(m + 1, 0U);
+        for (const auto& nz : nzs)
+        {
+            ++this->_ptr[nz.i + 1];
+            this->_col.push_back(nz.j);
+            this->_var.push_back(nz.k);
+            this->_val.push_back(nz.a);
+        }
+        std::partial_sum(
+            this->_ptr.begin(), this->_ptr.end(), this->_ptr.begin());
+    }
+
+    /*!
+     * @brief sum_k x_k F_k(i, j), for j \le i
+     *
+     * @param[in] i
+     * @param[in] j
+     * @param[in] x
+     * @return double
+     */
+    auto dot(size_t i, size_t j, const Arr& x) const -> double
+    {
+        const auto first = this->_col.begin() + this->_ptr[i];
+        const auto last = this->_col.begin() + this->_ptr[i + 1];
+        const auto [lo, hi] = std::equal_range(first, last, j);
+        auto res = 0.;
+        for (auto t = size_t(lo - this->_col.begin());
+             t != size_t(hi - this->_col.begin()); ++t)
+        {
+            res += this->_val[t] * x(this->_var[t]);
+        }
+        return res;
+    }
+
+    /*!
+     * @brief A -= sum_k x_k F_k, both triangles
+     *
+     *    Only the nonzeros are visited, each entry in increasing k as a
+     *    dense loop over k would.
+     *
+     * @param[in] x
+     * @param[in,out] A m x m
+     */
+    void sym_sub(const Arr& x, Arr& A) const
+    {
+        const auto m = this->_ptr.size() - 1;
+        for (auto i = 0U; i != m; ++i)
+        {
+            for (auto t = this->_ptr[i]; t != this->_ptr[i + 1]; ++t)
+            {
+                const auto j = this->_col[t];
+                const auto a = this->_val[t] * x(this->_var[t]);
+                A(i, j) -= a;
+                if (j != i)
+                {
+                    A(j, i) -= a;
+                }
+            }
+        }
+    }
+
+    /*!
+     * @brief y = (sum_k c_k F_k) u, both triangles
+     *
+     * @param[in] c coefficients
+     * @param[in] u
+     * @param[out] y
+     */
+    void sym_matvec(const Arr& c, const double* u, double* y) const
+    {
+        const auto m = this->_ptr.size() - 1;
+        std::fill(y, y + m, 0.);
+        for (auto i = 0U; i != m; ++i)
+        {
+            auto yi = 0.;
+            for (auto t = this->_ptr[i]; t != this->_ptr[i + 1]; ++t)
+            {
+                const auto j = this->_col[t];
+                const auto a = c(this->_var[t]) * this->_val[t];
+                yi += a * u[j];
+                if (j != i)
+                {
+                    y[j] += a * u[i];
+                }
+            }
+            y[i] += yi;
+        }
+    }
+
+    /*!
+     * @brief g_k = s * v' F_k(p, p) v, for all k at once
+     *
+     *    Only the nonzeros within the rows of the witness are visited.
+     *
+     * @param[in] v witness vector
+     * @param[in] p rows [start, stop) of the witness
+     * @param[in] s scale factor
+     * @param[out] g
+     */
+    void sym_quad(const Arr& v, const std::pair<size_t, size_t>& p,
+        double s, Arr& g) const
+    {
+        std::fill(g.begin(), g.end(), 0.);
+        const auto [start, stop] = p;
+        for (auto i = start; i != stop; ++i)
+        {
+            const auto vi = s * v(i);
+            const auto first = this->_col.begin() + this->_ptr[i];
+            const auto last = this->_col.begin() + this->_ptr[i + 1];
+            for (auto t = size_t(std::lower_bound(first, last, start)
+                     - this->_col.begin());
+                 t != this->_ptr[i + 1]; ++t)
+            {
+                const auto j = this->_col[t];
+                const auto w = (i == j ? 1. : 2.) * vi * v(j);
+                g(this->_var[t]) += w * this->_val[t];
+            }
+        }
+    }
+};
+
+} // namespace detail
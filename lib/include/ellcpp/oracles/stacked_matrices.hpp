@@ -0,0 +1,264 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <gsl/span>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <xtensor-blas/xlinalg.hpp>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xmanipulation.hpp>
+
+namespace detail
+{
+
+using Arr = xt::xarray<double, xt::layout_type::row_major>;
+
+/*!
+ * @brief Stack the matrices F_k, one per row
+ *
+ *    Row k of the result holds F_k (or its transpose) in row-major
+ *    order, so that for points X (one per row), the product X * stack(F)
+ *    holds sum_k x_k F_k of all the points at once (one GEMM instead of
+ *    a sequence of axpys per point).
+ *
+ * @param[in] F
+ * @param[in] transposed stack F_k' instead of F_k
+ * @return Arr of shape (len(F), rows * cols)
+ */
+inline auto stack(gsl::span<const Arr> F, bool transposed = false) -> Arr
+{
+    const auto rows = F[0].shape()[0];
+    const auto cols = F[0].shape()[1];
+    auto res = Arr {xt::zeros<double>({size_t(F.size()), rows * cols})};
+    for (auto k = 0U; k != F.size(); ++k)
+    {
+        auto l = size_t {0};
+        if (transposed)
+        {
+            for (auto j = 0U; j != cols; ++j)
+            {
+                for (auto i = 0U; i != rows; ++i)
+                {
+                    res(k, l++) = F[k](i, j);
+                }
+            }
+        }
+        else
+        {
+            for (auto i = 0U; i != rows; ++i)
+            {
+                for (auto j = 0U; j != cols; ++j)
+                {
+                    res(k, l++) = F[k](i, j);
+                }
+            }
+        }
+    }
+    return res;
+}
+
+/*!
+ * @brief Compiled layout of symmetric F_k: packed lower triangle, k innermost
+ *
+ *    Row i (i + 1) / 2 + j (j \le i) of the result holds F_0(i, j), ...,
+ *    F_{n-1}(i, j) contiguously, so that sum_k x_k F_k(i, j) is a
+ *    contiguous dot product with x (see packed_dot()).
+ *
+ * @param[in] F
+ * @return Arr of shape (m (m + 1) / 2, len(F))
+ */
+inline auto pack_lower(gsl::span<const Arr> F) -> Arr
+{
+    if (F.size() == 0)
+    {
+        return Arr {xt::zeros<double>({size_t {0}, size_t {0}})};
+    }
+    const auto m = F[0].shape()[0];
+    const auto n = size_t(F.size());
+    auto res = Arr {xt::zeros<double>({m * (m + 1) / 2, n})};
+    auto* r = res.data();
+    for (auto i = 0U; i != m; ++i)
+    {
+        for (auto j = 0U; j <= i; ++j)
+        {
+            for (auto k = 0U; k != n; ++k)
+            {
+                *r++ = F[k](i, j);
+            }
+        }
+    }
+    return res;
+}
+
+/*!
+ * @brief sum_k x_k F_k(i, j), for j \le i
+ *
+ *    Four independent partial sums, so that the loop can be vectorized.
+ *
+ * @param[in] Fc as returned by pack_lower()
+ * @param[in] i
+ * @param[in] j
+ * @param[in] x only the first len(F) entries are used
+ * @return double
+ */
+inline auto packed_dot(const Arr& Fc, size_t i, size_t j, const Arr& x)
+    -> double
+{
+    const auto n = Fc.shape()[1];
+    const auto* f = Fc.data() + (i * (i + 1) / 2 + j) * n;
+    const auto* y = x.data();
+    auto s0 = 0.;
+    auto s1 = 0.;
+    auto s2 = 0.;
+    auto s3 = 0.;
+    auto k = size_t {0};
+    for (; k + 4 <= n; k += 4)
+    {
+        s0 += f[k] * y[k];
+        s1 += f[k + 1] * y[k + 1];
+        s2 += f[k + 2] * y[k + 2];
+        s3 += f[k + 3] * y[k + 3];
+    }
+    for (; k != n; ++k)
+    {
+        s0 += f[k] * y[k];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+/*!
+ * @brief g_k = s * w' F_k(rows, rows) w, for all k at once
+ *
+ *    One contiguous axpy per pair of rows, over all the k. When
+ *    n * len^2 is large, the k are split among threads.
+ *
+ * @tparam Row
+ * @tparam Val
+ * @param[in] Fc as returned by pack_lower()
+ * @param[in] len number of rows
+ * @param[in] row row(a) is the a-th row
+ * @param[in] val val(a) is the weight w of the a-th row
+ * @param[in] s scale factor
+ * @param[out] g
+ */
+template <typename Row, typename Val>
+inline void packed_sym_quad(const Arr& Fc, size_t len, Row&& row, Val&& val,
+    double s, Arr& g)
+{
+    constexpr auto parallel_work = size_t {1} << 20; // flops
+    constexpr auto min_chunk = size_t {64};          // k per thread
+
+    const auto n = Fc.shape()[1];
+    auto* gp = g.data();
+    std::fill(gp, gp + n, 0.);
+
+    auto run = [&](size_t k0, size_t k1) {
+        for (auto a = 0U; a != len; ++a)
+        {
+            const auto i = row(a);
+            const auto vi = s * val(a);
+            for (auto b = 0U; b <= a; ++b)
+            {
+                const auto j = row(b);
+                const auto w = (a == b ? 1. : 2.) * vi * val(b);
+                const auto [lo, hi] = std::minmax(i, j);
+                const auto* f = Fc.data() + (hi * (hi + 1) / 2 + lo) * n;
+                for (auto k = k0; k != k1; ++k)
+                {
+                    gp[k] += w * f[k];
+                }
+            }
+        }
+    };
+
+    const auto work = n * len * (len + 1) / 2;
+    const auto n_threads = std::min<size_t>(
+        std::max(std::thread::hardware_concurrency(), 1U), n / min_chunk);
+    if (work < parallel_work || n_threads < 2)
+    {
+        run(0, n);
+        return;
+    }
+    auto tasks = std::vector<std::future<void>> {};
+    const auto chunk = (n + n_threads - 1) / n_threads;
+    for (auto k0 = chunk; k0 < n; k0 += chunk)
+    {
+        tasks.push_back(
+            std::async(std::launch::async, run, k0, std::min(k0 + chunk, n)));
+    }
+    run(0, chunk);
+    for (auto& task : tasks)
+    {
+        task.get();
+    }
+}
+
+/*!
+ * @brief g_k = s * v' F_k(p, p) v, for all k at once
+ *
+ *    With w(i, j) = v_i v_j (twice off the diagonal), g = s * Fc' w: one
+ *    contiguous axpy per entry of the lower triangle of (p, p), over all
+ *    the k.
+ *
+ * @param[in] Fc as returned by pack_lower()
+ * @param[in] v witness vector
+ * @param[in] p rows [start, stop) of the witness
+ * @param[in] s scale factor
+ * @param[out] g
+ */
+inline void packed_sym_quad(const Arr& Fc, const Arr& v,
+    const std::pair<size_t, size_t>& p, double s, Arr& g)
+{
+    const auto [start, stop] = p;
+    packed_sym_quad(
+        Fc, stop - start, [start = start](size_t a) { return start + a; },
+        [&v, start = start](size_t a) { return v(start + a); }, s, g);
+}
+
+/*!
+ * @brief g_k = s * w' F_k(rows, rows) w, for a witness of a permuted
+ *        matrix (see pivot_order)
+ *
+ * @param[in] Fc as returned by pack_lower()
+ * @param[in] rows rows of the witness, in any order
+ * @param[in] w w[a] is the entry of rows[a]
+ * @param[in] s scale factor
+ * @param[out] g
+ */
+inline void packed_sym_quad(const Arr& Fc, const std::vector<size_t>& rows,
+    const double* w, double s, Arr& g)
+{
+    packed_sym_quad(
+        Fc, rows.size(), [&rows](size_t a) { return rows[a]; },
+        [w](size_t a) { return w[a]; }, s, g);
+}
+
+/*!
+ * @brief sum_k x_k F_k(i, j), j \le i, for all the points x (rows of X)
+ *
+ * @param[in] X points, one per row
+ * @param[in] Fc as returned by pack_lower()
+ * @return Arr of shape (len(X), m (m + 1) / 2), one GEMM
+ */
+inline auto assemble_lower(const Arr& X, const Arr& Fc) -> Arr
+{
+    return Arr {xt::transpose(xt::linalg::dot(Fc, xt::transpose(X)))};
+}
+
+/*!
+ * @brief sum_k x_k F_k for all the points x (rows of X)
+ *
+ * @param[in] X points, one per row
+ * @param[in] Fs as returned by stack()
+ * @return Arr of shape (len(X), rows * cols)
+ */
+inline auto assemble(const Arr& X, const Arr& Fs) -> Arr
+{
+    return xt::linalg::dot(X, Fs);
+}
+
+} // namespace detail
@@ -0,0 +1,163 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace detail
+{
+
+template <typename Oracle, typename T>
+using discretize_t =
+    decltype(std::declval<Oracle&>().discretize(std::declval<T>()));
+
+template <typename Void, typename Oracle, typename T>
+struct has_discretize_impl : std::false_type
+{
+};
+
+template <typename Oracle, typename T>
+struct has_discretize_impl<std::void_t<discretize_t<Oracle, T>>, Oracle, T>
+    : std::true_type
+{
+};
+
+/*!
+ * @brief Does `Oracle` tell which discrete point it evaluates at x?
+ *
+ *    Such an oracle provides `discretize(x)`, returning the point that
+ *    the next call `Omega(x, t, false)` will assess.
+ *
+ * @tparam Oracle
+ * @tparam T type of x
+ */
+template <typename Oracle, typename T>
+constexpr bool has_discretize_v =
+    has_discretize_impl<void, std::decay_t<Oracle>, T>::value;
+
+/*!
+ * @brief Memo of cuts at discrete points, for cutting_plane_q()
+ *
+ *    A cut obtained at the discrete point xd and targeted to the center xc
+ *
+ *        g' (x - xc) + beta \le 0
+ *
+ *    is stored relative to xd, i.e. with beta - g' (xd - xc). When the
+ *    same point comes up again it is re-targeted to the new center in
+ *    O(n), without running the oracle. The cuts depend on t, hence the
+ *    memo is cleared whenever t changes.
+ *
+ * @tparam Arr
+ * @tparam Cut
+ * @tparam T type of t
+ */
+template <typename Arr, typename Cut, typename T>
+class point_memo
+{
+  private:
+    struct hasher
+    {
+        auto operator()(const Arr& x) const -> std::size_t
+        {
+            return boost::hash_range(x.begin(), x.end());
+        }
+    };
+
+    struct equal
+    {
+        auto operator()(const Arr& x, const Arr& y) const -> bool
+        {
+            return x.size() == y.size()
+                && std::equal(x.begin(), x.end(), y.begin());
+        }
+    };
+
+    std::unordered_map<Arr, Cut, hasher, equal> _cuts;
+    T _t {};
+
+    /*!
+     * @brief g' (xd - xc)
+     */
+    static auto _shift(const Arr& g, const Arr& xd, const Arr& xc) -> double
+    {
+        auto res = 0.;
+        for (auto i = 0U; i != g.size(); ++i)
+        {
+            res += g(i) * (xd(i) - xc(i));
+        }
+        return res;
+    }
+
+  public:
+    /*!
+     * @brief Look up the cut at xd, for the best-so-far value t
+     *
+     * @param[in] xd
+     * @param[in] t
+     * @return the stored cut, or nullptr
+     */
+    auto find(const Arr& xd, const T& t) -> Cut*
+    {
+        if (t != this->_t)
+        {
+            this->_cuts.clear();
+            this->_t = t;
+            return nullptr;
+        }
+        auto it = this->_cuts.find(xd);
+        if (it == this->_cuts.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    /*!
+     * @brief Store a cut obtained at xd and targeted to xc
+     *
+     * @param[in] xd
+     * @param[in] cut
+     * @param[in] xc
+     * @param[in] t
+     */
+    void store(const Arr& xd, const Cut& cut, const Arr& xc, const T& t)
+    {
+        if (t != this->_t)
+        {
+            this->_cuts.clear();
+            this->_t = t;
+        }
+        auto& [g, beta] = this->_cuts.insert_or_assign(xd, cut).first->second;
+        beta -= _shift(g, xd, xc);
+    }
+
+    /*!
+     * @brief Update S with the stored cut at xd, re-targeted to xc
+     *
+     *    The cut is shifted in place and restored afterwards.
+     *
+     * @tparam Space
+     * @param[in,out] S
+     * @param[in,out] cut as returned by find()
+     * @param[in] xd
+     * @param[in] xc the center of S (not copied)
+     * @return std::tuple<CUTStatus, double>
+     */
+    template <typename Space>
+    auto update(Space& S, Cut& cut, const Arr& xd, const Arr& xc)
+    {
+        auto& [g, beta] = cut;
+        auto beta0 = beta;
+        beta += _shift(g, xd, xc);
+        auto res = S.update(cut);
+        beta = std::move(beta0);
+        return res;
+    }
+};
+
+} // namespace detail
@@ -1,6 +1,7 @@
 // -*- coding: utf-8 -*-
 #pragma once
 
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 #include <xtensor/xarray.hpp>
@@ -27,3 +28,19 @@ constexpr auto zeros(const T& x) ->
 {
     return T {xt::zeros<double>({x.size()})};
 }
+
+/*!
+ * @brief Set x to a zero vector of size n, reusing its storage if possible
+ *
+ * @param[in,out] x
+ * @param[in] n
+ */
+inline void fill_zeros(Arr& x, size_t n)
+{
+    if (x.dimension() != 1 || x.size() != n)
+    {
+        x = xt::zeros<double>({n});
+        return;
+    }
+    x.fill(0.);
+}
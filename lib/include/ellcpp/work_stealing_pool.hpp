@@ -0,0 +1,247 @@
+// -*- coding: utf-8 -*-
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*!
+ * @brief Work-stealing thread pool
+ *
+ *    Each worker owns a task deque. A worker pops its own tasks from the
+ *    back (LIFO, cache friendly) and, when it runs dry, steals from the
+ *    front of the other deques (FIFO). Tasks submitted from a worker go to
+ *    that worker's deque; tasks submitted from outside are dealt round
+ *    robin.
+ */
+class work_stealing_pool
+{
+  public:
+    using Task = std::function<void()>;
+
+  private:
+    struct task_queue
+    {
+        std::mutex mtx;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<task_queue>> _queues;
+    std::vector<std::thread> _threads;
+
+    std::mutex _mtx;
+    std::condition_variable _cv_task;
+    std::condition_variable _cv_idle;
+    long _queued = 0;  //!< tasks not yet taken (guarded by _mtx)
+    long _pending = 0; //!< tasks not yet finished (guarded by _mtx)
+    size_t _next = 0;  //!< round robin for external submission
+    bool _stop = false;
+    std::exception_ptr _error;
+
+    static inline thread_local const work_stealing_pool* _owner = nullptr;
+    static inline thread_local size_t _index = 0;
+
+  public:
+    /*!
+     * @brief Construct a new work stealing pool object
+     *
+     * @param[in] n_workers number of worker threads
+     */
+    explicit work_stealing_pool(
+        size_t n_workers = std::thread::hardware_concurrency())
+    {
+        if (n_workers == 0)
+        {
+            n_workers = 1;
+        }
+        for (auto i = 0U; i != n_workers; ++i)
+        {
+            this->_queues.emplace_back(std::make_unique<task_queue>());
+        }
+        for (auto i = 0U; i != n_workers; ++i)
+        {
+            this->_threads.emplace_back([this, i] { this->_run(i); });
+        }
+    }
+
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+    /**
+     * @brief Destroy the work stealing pool object
+     *
+     * Remaining tasks are finished before the workers are joined.
+     */
+    ~work_stealing_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->_mtx);
+            this->_stop = true;
+        }
+        this->_cv_task.notify_all();
+        for (auto& th : this->_threads)
+        {
+            th.join();
+        }
+    }
+
+    /*!
+     * @brief Number of worker threads
+     *
+     * @return size_t
+     */
+    [[nodiscard]] auto size() const noexcept -> size_t
+    {
+        return this->_threads.size();
+    }
+
+    /*!
+     * @brief Index of the calling worker, in [0, size())
+     *
+     * Useful for indexing per-worker scratch storage. Returns size() if
+     * the caller is not a worker of this pool.
+     *
+     * @return size_t
+     */
+    [[nodiscard]] auto worker_index() const noexcept -> size_t
+    {
+        return _owner == this ? _index : this->size();
+    }
+
+    /*!
+     * @brief Submit a task
+     *
+     * @param[in] task
+     */
+    void submit(Task task)
+    {
+        const auto n = this->_queues.size();
+        auto i = this->worker_index();
+        {
+            std::lock_guard<std::mutex> lock(this->_mtx);
+            ++this->_pending;
+            if (i == n)
+            {
+                i = this->_next++ % n;
+            }
+        }
+        {
+            auto& q = *this->_queues[i];
+            std::lock_guard<std::mutex> lock(q.mtx);
+            q.tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(this->_mtx);
+            ++this->_queued;
+        }
+        this->_cv_task.notify_one();
+    }
+
+    /*!
+     * @brief Wait until all submitted tasks are finished
+     *
+     * Rethrows the first exception thrown by a task, if any.
+     * Must not be called from a worker.
+     */
+    void wait_idle()
+    {
+        std::unique_lock<std::mutex> lock(this->_mtx);
+        this->_cv_idle.wait(lock, [this] { return this->_pending == 0; });
+        if (this->_error)
+        {
+            auto error = std::exchange(this->_error, nullptr);
+            std::rethrow_exception(error);
+        }
+    }
+
+  private:
+    /*!
+     * @brief Take a task, own deque first, then steal
+     *
+     * @param[in] i worker index
+     * @param[out] task
+     * @return true if a task is taken
+     */
+    auto _take(size_t i, Task& task) -> bool
+    {
+        const auto n = this->_queues.size();
+        for (auto k = 0U; k != n; ++k)
+        {
+            auto& q = *this->_queues[(i + k) % n];
+            std::lock_guard<std::mutex> lock(q.mtx);
+            if (q.tasks.empty())
+            {
+                continue;
+            }
+            if (k == 0)
+            { // own deque: LIFO
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            }
+            else
+            { // steal: FIFO
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /*!
+     * @brief Worker loop
+     *
+     * @param[in] i worker index
+     */
+    void _run(size_t i)
+    {
+        _owner = this;
+        _index = i;
+
+        Task task;
+        while (true)
+        {
+            if (this->_take(i, task))
+            {
+                {
+                    std::lock_guard<std::mutex> lock(this->_mtx);
+                    --this->_queued;
+                }
+                try
+                {
+                    task();
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(this->_mtx);
+                    if (!this->_error)
+                    {
+                        this->_error = std::current_exception();
+                    }
+                }
+                task = nullptr;
+                std::lock_guard<std::mutex> lock(this->_mtx);
+                if (--this->_pending == 0)
+                {
+                    this->_cv_idle.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(this->_mtx);
+            this->_cv_task.wait(lock,
+                [this] { return this->_stop || this->_queued > 0; });
+            if (this->_stop && this->_queued <= 0)
+            {
+                return;
+            }
+        }
+    }
+};
@@ -5,7 +5,9 @@
 Negative cycle detection for weighed graphs.
 **/
 #include <cassert>
+#include <cstddef>
 #include <py2cpp/py2cpp.hpp>
+#include <utility>
 #include <vector>
 
 /*!
@@ -26,8 +28,24 @@ class negCycleFinder
     using node_t = typename Graph::node_t;
     using edge_t = typename Graph::edge_t;
 
-    py::dict<node_t, node_t> _pred {};
-    py::dict<node_t, edge_t> _edge {};
+    /*!
+     * @brief Per-node state, kept across calls
+     *
+     *    The entries are stamped rather than erased, so that once every
+     *    node has an entry, a search does no heap allocation.
+     */
+    struct node_info
+    {
+        node_t pred {};         //!< predecessor on the policy graph
+        edge_t edge {};         //!< edge from pred
+        size_t pred_round = 0;  //!< pred is valid iff == _round
+        node_t root {};         //!< start of the walk that visited it
+        size_t visit_round = 0; //!< visited iff == _visit
+    };
+
+    py::dict<node_t, node_info> _info {};
+    size_t _round = 0; //!< one per call of find_neg_cycle()
+    size_t _visit = 0; //!< one per call of _find_cycle()
 
   private:
     const Graph& _G; // const???
@@ -57,8 +75,28 @@ class negCycleFinder
     auto find_neg_cycle(Container&& dist, WeightFn&& get_weight)
         -> std::vector<edge_t>
     {
-        this->_pred.clear();
-        this->_edge.clear();
+        auto cycle = std::vector<edge_t> {};
+        this->find_neg_cycle(std::forward<Container>(dist),
+            std::forward<WeightFn>(get_weight), cycle);
+        return cycle;
+    }
+
+    /*!
+     * @brief find negative cycle, into a reusable buffer
+     *
+     * @tparam Container
+     * @tparam WeightFn
+     * @param[in,out] dist
+     * @param[in] get_weight
+     * @param[out] cycle the edges of the cycle, or empty
+     * @return true if a negative cycle is found
+     */
+    template <typename Container, typename WeightFn>
+    auto find_neg_cycle(Container&& dist, WeightFn&& get_weight,
+        std::vector<edge_t>& cycle) -> bool
+    {
+        ++this->_round; // forget the predecessors of the last call
+        cycle.clear();
 
         while (this->_relax(dist, get_weight))
         {
@@ -66,13 +104,28 @@ class negCycleFinder
             if (v != this->_G.null_vertex())
             {
                 assert(this->_is_negative(v, dist, get_weight));
-                return this->_cycle_list(v);
+                this->_cycle_list(v, cycle);
+                return true;
             }
         }
-        return std::vector<edge_t> {}; // ???
+        return false;
     }
 
   private:
+    /*!
+     * @brief Does v have a predecessor in this call?
+     *
+     * @param[in] v
+     * @return true
+     * @return false
+     */
+    auto _has_pred(const node_t& v) const -> bool
+    {
+        const auto it = this->_info.find(v);
+        return it != this->_info.end()
+            && it->second.pred_round == this->_round;
+    }
+
     /*!
      * @brief Find a cycle on policy graph
      *
@@ -80,26 +133,29 @@ class negCycleFinder
      */
     auto _find_cycle() -> node_t
     {
-        auto visited = py::dict<node_t, node_t> {};
+        ++this->_visit; // forget the visits of the last call
 
         for (auto&& v : this->_G)
         {
-            if (visited.contains(v))
+            if (this->_info[v].visit_round == this->_visit)
             {
                 continue;
             }
             auto u = v;
             while (true)
             {
-                visited[u] = v;
-                if (!this->_pred.contains(u))
+                auto& iu = this->_info[u];
+                iu.visit_round = this->_visit;
+                iu.root = v;
+                if (!this->_has_pred(u))
                 {
                     break;
                 }
-                u = this->_pred[u];
-                if (visited.contains(u))
+                u = iu.pred;
+                const auto& iw = this->_info[u];
+                if (iw.visit_round == this->_visit)
                 {
-                    if (visited[u] == v)
+                    if (iw.root == v)
                     {
                         // if (this->_is_negative(u)) {
                         // should be "yield u";
@@ -138,8 +194,10 @@ class negCycleFinder
 
             if (dist[v] > d)
             {
-                this->_pred[v] = u;
-                this->_edge[v] = e; // ???
+                auto& iv = this->_info[v];
+                iv.pred = u;
+                iv.edge = e; // ???
+                iv.pred_round = this->_round;
                 dist[v] = d;
                 changed = true;
             }
@@ -151,19 +209,17 @@ class negCycleFinder
      * @brief generate a cycle list
      *
      * @param[in] handle
-     * @return std::vector<edge_t>
+     * @param[out] cycle
      */
-    auto _cycle_list(const node_t& handle) -> std::vector<edge_t>
+    void _cycle_list(const node_t& handle, std::vector<edge_t>& cycle)
     {
         auto v = handle;
-        auto cycle = std::vector<edge_t> {}; // ???
         do
         {
-            const auto& u = this->_pred[v];
-            cycle.push_back(this->_edge[v]); // ???
-            v = u;
+            const auto& iv = this->_info[v];
+            cycle.push_back(iv.edge); // ???
+            v = iv.pred;
         } while (v != handle);
-        return cycle;
     }
 
     /*!
@@ -184,8 +240,8 @@ class negCycleFinder
         auto v = handle;
         do
         {
-            const auto u = this->_pred[v];
-            const auto e = this->_edge[v];
+            const auto u = this->_info[v].pred;
+            const auto e = this->_info[v].edge;
             const auto wt = get_weight(e); // ???
             if (dist[v] > dist[u] + wt)
             {
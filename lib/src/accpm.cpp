@@ -0,0 +1,330 @@
+#include <algorithm>
+#include <cmath>
+#include <ellcpp/accpm.hpp>
+#include <ellcpp/cut_config.hpp>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <xtensor-blas/xlinalg.hpp>
+
+using Arr = xt::xarray<double, xt::layout_type::row_major>;
+
+/*!
+ * @brief Construct a new accpm object
+ *
+ * @param[in] val
+ * @param[in] x
+ */
+accpm::accpm(const Arr& val, Arr x)
+    : max_cuts {4 * x.size()}
+    , _n {x.size()}
+    , _lb {x - xt::sqrt(val)}
+    , _ub {x + xt::sqrt(val)}
+    , _xc {std::move(x)}
+{
+    Arr grad;
+    this->_derivatives(this->_xc, grad, this->_H);
+}
+
+/*!
+ * @brief Construct a new accpm object
+ *
+ * @param[in] alpha
+ * @param[in] x
+ */
+accpm::accpm(const double& alpha, Arr x)
+    : accpm {Arr(alpha * xt::ones<double>({x.size()})), std::move(x)}
+{
+}
+
+/*!
+ * @brief Set the xc object
+ *
+ * @param[in] xc
+ */
+void accpm::set_xc(const Arr& xc)
+{
+    this->_xc = xc;
+    Arr grad;
+    this->_derivatives(this->_xc, grad, this->_H);
+}
+
+/*!
+ * @brief Gradient and Hessian of the barrier at x
+ *
+ * @param[in] x
+ * @param[out] grad
+ * @param[out] H
+ */
+void accpm::_derivatives(const Arr& x, Arr& grad, Arr& H) const
+{
+    const auto n = this->_n;
+    grad = xt::zeros<double>({n});
+    H = xt::zeros<double>({n, n});
+    for (auto i = 0U; i != n; ++i)
+    {
+        const auto u = 1. / (this->_ub(i) - x(i));
+        const auto l = 1. / (x(i) - this->_lb(i));
+        grad(i) = u - l;
+        H(i, i) = u * u + l * l;
+    }
+    for (auto k = 0U; k != this->_b.size(); ++k)
+    {
+        const auto& a = this->_A[k];
+        const auto w = 1. / (this->_b[k] - xt::linalg::dot(a, x)());
+        const auto wsq = w * w;
+        for (auto i = 0U; i != n; ++i)
+        {
+            grad(i) += w * a(i);
+            const auto wa = wsq * a(i);
+            for (auto j = 0U; j <= i; ++j)
+            {
+                H(i, j) += wa * a(j);
+            }
+        }
+    }
+    for (auto i = 0U; i != n; ++i)
+    {
+        for (auto j = 0U; j < i; ++j)
+        {
+            H(j, i) = H(i, j);
+        }
+    }
+}
+
+/*!
+ * @brief Largest step s such that x + s d stays strictly inside
+ *
+ * @param[in] x
+ * @param[in] d
+ * @return double
+ */
+auto accpm::_max_step(const Arr& x, const Arr& d) const -> double
+{
+    auto s_max = std::numeric_limits<double>::infinity();
+    for (auto i = 0U; i != this->_n; ++i)
+    {
+        if (d(i) > 0.)
+        {
+            s_max = std::min(s_max, (this->_ub(i) - x(i)) / d(i));
+        }
+        else if (d(i) < 0.)
+        {
+            s_max = std::min(s_max, (this->_lb(i) - x(i)) / d(i));
+        }
+    }
+    for (auto k = 0U; k != this->_b.size(); ++k)
+    {
+        const auto ad = xt::linalg::dot(this->_A[k], d)();
+        if (ad > 0.)
+        {
+            const auto slack = this->_b[k] - xt::linalg::dot(this->_A[k], x)();
+            s_max = std::min(s_max, slack / ad);
+        }
+    }
+    return s_max;
+}
+
+/*!
+ * @brief Warm start: walk from x into the slab lo < g' x < hi
+ *
+ *    Step along the unit Dikin direction d = -+H^-1 g / sqrt(g' H^-1 g)
+ *    to the middle of the part of the ray inside the slab. If the ray
+ *    misses it, go half way to the boundary and repeat with the Hessian
+ *    at the new point (affine scaling).
+ *
+ * @param[in,out] x strictly inside the polyhedron
+ * @param[in] g
+ * @param[in] lo
+ * @param[in] hi
+ * @return false if the slab is not reached
+ */
+auto accpm::_enter(Arr& x, const Arr& g, double lo, double hi) const -> bool
+{
+    auto H = this->_H;
+    Arr grad;
+    for (auto niter = 0U; niter != this->newton_max_it; ++niter)
+    {
+        const auto Hg = Arr {xt::linalg::solve(H, g)};
+        const auto w = std::sqrt(xt::linalg::dot(g, Hg)());
+        const auto gx = xt::linalg::dot(g, x)();
+        const auto down = gx >= lo; // decrease g' x
+        const auto d = Arr {Hg / (down ? -w : w)};
+        const auto s_max = this->_max_step(x, d);
+        const auto s_in = std::max(0., down ? (gx - hi) / w : (lo - gx) / w);
+        const auto s_out =
+            std::min(s_max, down ? (gx - lo) / w : (hi - gx) / w);
+        if (s_in < s_out)
+        {
+            x += ((s_in + s_out) / 2.) * d;
+            return true;
+        }
+        x += (s_max / 2.) * d;
+        this->_derivatives(x, grad, H);
+    }
+    return false;
+}
+
+/*!
+ * @brief Re-center by damped Newton steps, starting from xc
+ */
+void accpm::_center()
+{
+    Arr grad;
+    for (auto niter = 0U; niter != this->newton_max_it; ++niter)
+    {
+        this->_derivatives(this->_xc, grad, this->_H);
+        const auto dx = Arr {-xt::linalg::solve(this->_H, grad)};
+        const auto lambdasq = -xt::linalg::dot(grad, dx)();
+        if (lambdasq < this->newton_tol)
+        {
+            return;
+        }
+        // damped step 1/(1 + lambda) stays inside (self-concordance)
+        const auto step =
+            lambdasq > 0.25 ? 1. / (1. + std::sqrt(lambdasq)) : 1.;
+        this->_xc += step * dx;
+    }
+    this->_derivatives(this->_xc, grad, this->_H);
+}
+
+/*!
+ * @brief Drop redundant cuts, then the least relevant ones beyond max_cuts
+ *
+ *    At the analytic center the polyhedron lies in the Dikin ellipsoid
+ *    scaled by M (the number of constraints), so a cut whose normalized
+ *    slack s_k / sqrt(a_k' H^-1 a_k) exceeds M is redundant.
+ */
+void accpm::_prune()
+{
+    const auto m = this->_b.size();
+    if (m == 0)
+    {
+        return;
+    }
+    const auto M = double(m + 2 * this->_n);
+    const auto Hinv = Arr {xt::linalg::inv(this->_H)};
+    auto ratio = std::vector<double>(m);
+    for (auto k = 0U; k != m; ++k)
+    {
+        const auto& a = this->_A[k];
+        const auto slack = this->_b[k] - xt::linalg::dot(a, this->_xc)();
+        const auto Ha = Arr {xt::linalg::dot(Hinv, a)};
+        ratio[k] = slack / std::sqrt(xt::linalg::dot(a, Ha)());
+    }
+
+    auto order = std::vector<size_t>(m);
+    std::iota(order.begin(), order.end(), 0U);
+    std::stable_sort(order.begin(), order.end(),
+        [&](size_t i, size_t j) { return ratio[i] < ratio[j]; });
+
+    auto keep = std::vector<bool>(m, false);
+    for (auto r = 0U; r != m && r != this->max_cuts; ++r)
+    {
+        const auto k = order[r];
+        keep[k] = ratio[k] <= M;
+    }
+
+    auto j = 0U;
+    for (auto k = 0U; k != m; ++k)
+    {
+        if (!keep[k])
+        {
+            continue;
+        }
+        if (j != k)
+        {
+            this->_A[j] = std::move(this->_A[k]);
+            this->_b[j] = this->_b[k];
+        }
+        ++j;
+    }
+    if (j == m)
+    {
+        return;
+    }
+    this->_A.resize(j);
+    this->_b.resize(j);
+    this->_center();
+}
+
+/*!
+ * @brief Add the cut(s) and move to the new analytic center
+ *
+ *        g' (x - xc) + beta0 \le 0
+ *        g' (x - xc) + beta1 \ge 0
+ *
+ * @tparam T
+ * @param[in] cut
+ * @return std::tuple<CUTStatus, double>
+ */
+template <typename T>
+std::tuple<CUTStatus, double> accpm::update(const std::tuple<Arr, T>& cut)
+{
+    const auto& g = std::get<0>(cut);
+    const auto& beta = std::get<1>(cut);
+
+    auto b0 = 0.;
+    auto b1 = std::numeric_limits<double>::infinity();
+    if constexpr (std::is_same_v<T, double>)
+    {
+        b0 = beta;
+    }
+    else
+    { // parallel cut
+        b0 = beta[0];
+        if (beta.shape()[0] >= 2 && this->use_parallel_cut)
+        {
+            b1 = beta[1];
+        }
+    }
+
+    const auto Hg = Arr {xt::linalg::solve(this->_H, g)};
+    const auto omega = xt::linalg::dot(g, Hg)();
+    const auto M = double(this->_b.size() + 2 * this->_n);
+    const auto tsq = M * M * omega;
+    const auto tau = std::sqrt(tsq);
+
+    if (b0 > tau || b1 < b0)
+    {
+        return {CUTStatus::nosoln, tsq}; // no sol'n
+    }
+    const auto add_upper = b0 > -tau;
+    const auto add_lower = b1 < tau;
+    if (!add_upper && !add_lower)
+    {
+        return {CUTStatus::noeffect, tsq}; // no effect
+    }
+
+    const auto gxc = xt::linalg::dot(g, this->_xc)();
+    auto x = this->_xc;
+    if (!this->_enter(x, g, gxc - b1, gxc - b0))
+    {
+        // Newton did not get there: a numerical failure, not an empty set
+        return {CUTStatus::noeffect, tsq};
+    }
+
+    if (add_upper)
+    {
+        this->_A.emplace_back(g);
+        this->_b.emplace_back(gxc - b0);
+    }
+    if (add_lower)
+    {
+        this->_A.emplace_back(-g);
+        this->_b.emplace_back(b1 - gxc);
+    }
+    this->_xc = std::move(x);
+    this->_center();
+    if (this->_b.size() > this->max_cuts)
+    {
+        this->_prune();
+    }
+    return {CUTStatus::success, tsq};
+}
+
+// Instantiation
+template std::tuple<CUTStatus, double> accpm::update(
+    const std::tuple<Arr, double>& cut);
+template std::tuple<CUTStatus, double> accpm::update(
+    const std::tuple<Arr, Arr>& cut);
@@ -0,0 +1,366 @@
+#include <algorithm>
+#include <atomic>
+#include <ellcpp/oracles/chordal_lmi_oracle.hpp>
+#include <ellcpp/utility.hpp>
+#include <future>
+#include <limits>
+#include <set>
+#include <thread>
+
+using Arr = xt::xarray<double, xt::layout_type::row_major>;
+using Cut = std::tuple<Arr, double>;
+using Graph = std::vector<std::set<size_t>>;
+
+static constexpr auto npos = std::numeric_limits<size_t>::max();
+
+/*!
+ * @brief Add the off-diagonal nonzeros of A to the pattern G
+ *
+ * @param[in,out] G
+ * @param[in] A
+ */
+static void add_edges(Graph& G, const coo_matrix& A)
+{
+    for (auto t = 0U; t != A.val.size(); ++t)
+    {
+        const auto i = A.row[t];
+        const auto j = A.col[t];
+        if (i != j)
+        {
+            G[i].insert(j);
+            G[j].insert(i);
+        }
+    }
+}
+
+/*!
+ * @brief Connected components of G
+ *
+ * @param[in] G
+ * @return std::vector<std::vector<size_t>> sorted rows of each component
+ */
+static auto components(const Graph& G) -> std::vector<std::vector<size_t>>
+{
+    auto res = std::vector<std::vector<size_t>> {};
+    auto visited = std::vector<bool>(G.size(), false);
+    for (auto s = 0U; s != G.size(); ++s)
+    {
+        if (visited[s])
+        {
+            continue;
+        }
+        auto& rows = res.emplace_back();
+        auto stack = std::vector<size_t> {s};
+        visited[s] = true;
+        while (!stack.empty())
+        {
+            const auto i = stack.back();
+            stack.pop_back();
+            rows.push_back(i);
+            for (const auto j : G[i])
+            {
+                if (!visited[j])
+                {
+                    visited[j] = true;
+                    stack.push_back(j);
+                }
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+    }
+    return res;
+}
+
+/*!
+ * @brief Maximal cliques of a chordal extension of a component of G
+ *
+ *    Maximum cardinality search numbers the vertices; eliminating them in
+ *    the reverse order is a perfect elimination ordering when the
+ *    component is chordal (no fill), and gives a chordal extension
+ *    otherwise.
+ *
+ * @param[in] G
+ * @param[in] rows rows of the component
+ * @param[in] pos pos[rows[a]] == a
+ * @return std::vector<std::vector<size_t>> sorted rows of each clique,
+ *         smallest cliques first
+ */
+static auto chordal_cliques(const Graph& G, const std::vector<size_t>& rows,
+    const std::vector<size_t>& pos) -> std::vector<std::vector<size_t>>
+{
+    const auto nc = rows.size();
+
+    // maximum cardinality search
+    auto weight = std::vector<size_t>(nc, 0U);
+    auto numbered = std::vector<bool>(nc, false);
+    auto order = std::vector<size_t> {};
+    order.reserve(nc);
+    for (auto step = 0U; step != nc; ++step)
+    {
+        auto a = npos;
+        for (auto b = 0U; b != nc; ++b)
+        {
+            if (!numbered[b] && (a == npos || weight[b] > weight[a]))
+            {
+                a = b;
+            }
+        }
+        numbered[a] = true;
+        order.push_back(a);
+        for (const auto j : G[rows[a]])
+        {
+            if (!numbered[pos[j]])
+            {
+                ++weight[pos[j]];
+            }
+        }
+    }
+
+    // elimination game, in the reverse order
+    auto adj = std::vector<std::set<size_t>>(nc);
+    for (auto a = 0U; a != nc; ++a)
+    {
+        for (const auto j : G[rows[a]])
+        {
+            adj[a].insert(pos[j]);
+        }
+    }
+    auto eliminated = std::vector<bool>(nc, false);
+    auto candidates = std::vector<std::vector<size_t>> {};
+    for (auto it = order.rbegin(); it != order.rend(); ++it)
+    {
+        const auto a = *it;
+        auto later = std::vector<size_t> {};
+        for (const auto b : adj[a])
+        {
+            if (!eliminated[b])
+            {
+                later.push_back(b);
+            }
+        }
+        for (const auto b : later)
+        {
+            for (const auto c : later)
+            {
+                if (b != c)
+                {
+                    adj[b].insert(c); // fill
+                }
+            }
+        }
+        eliminated[a] = true;
+
+        auto& C = candidates.emplace_back();
+        C.push_back(rows[a]);
+        for (const auto b : later)
+        {
+            C.push_back(rows[b]);
+        }
+        std::sort(C.begin(), C.end());
+    }
+
+    // keep the maximal ones
+    std::sort(candidates.begin(), candidates.end(),
+        [](const auto& C1, const auto& C2) { return C1.size() > C2.size(); });
+    auto res = std::vector<std::vector<size_t>> {};
+    for (auto& C : candidates)
+    {
+        const auto is_subset = std::any_of(
+            res.begin(), res.end(), [&](const auto& K) {
+                return std::includes(K.begin(), K.end(), C.begin(), C.end());
+            });
+        if (!is_subset)
+        {
+            res.push_back(std::move(C));
+        }
+    }
+    std::reverse(res.begin(), res.end());
+    return res;
+}
+
+/*!
+ * @brief The LMI restricted to the principal block of the given rows
+ *
+ * @param[in] rows sorted
+ * @param[in,out] pos all npos, restored on return
+ * @param[in] F
+ * @param[in] B
+ * @return sparse_lmi_oracle
+ */
+static auto make_block(const std::vector<size_t>& rows,
+    std::vector<size_t>& pos, const std::vector<coo_matrix>& F,
+    const coo_matrix& B) -> sparse_lmi_oracle
+{
+    const auto nc = rows.size();
+    for (auto a = 0U; a != nc; ++a)
+    {
+        pos[rows[a]] = a;
+    }
+
+    auto restrict_to = [&](const coo_matrix& A) {
+        auto res = coo_matrix {};
+        for (auto t = 0U; t != A.val.size(); ++t)
+        {
+            const auto i = pos[A.row[t]];
+            const auto j = pos[A.col[t]];
+            if (i != npos && j != npos)
+            {
+                res.row.push_back(i);
+                res.col.push_back(j);
+                res.val.push_back(A.val[t]);
+            }
+        }
+        return res;
+    };
+
+    auto Fb = std::vector<coo_matrix> {};
+    Fb.reserve(F.size());
+    for (const auto& Fk : F)
+    {
+        Fb.push_back(restrict_to(Fk));
+    }
+    const auto Bc = restrict_to(B);
+    auto Bb = zeros({nc, nc});
+    for (auto t = 0U; t != Bc.val.size(); ++t)
+    {
+        const auto i = Bc.row[t];
+        const auto j = Bc.col[t];
+        Bb(i, j) += Bc.val[t];
+        if (i != j)
+        {
+            Bb(j, i) += Bc.val[t];
+        }
+    }
+
+    for (const auto i : rows)
+    {
+        pos[i] = npos;
+    }
+    return sparse_lmi_oracle {Fb, std::move(Bb)};
+}
+
+/*!
+ * @brief Construct a new chordal lmi oracle object
+ *
+ * @param[in] m dimension
+ * @param[in] F
+ * @param[in] B
+ */
+chordal_lmi_oracle::chordal_lmi_oracle(
+    size_t m, const std::vector<coo_matrix>& F, const coo_matrix& B)
+{
+    auto G = Graph(m);
+    add_edges(G, B);
+    for (const auto& Fk : F)
+    {
+        add_edges(G, Fk);
+    }
+
+    auto pos = std::vector<size_t>(m, npos);
+    for (const auto& rows : components(G))
+    {
+        const auto nc = rows.size();
+        for (auto a = 0U; a != nc; ++a)
+        {
+            pos[rows[a]] = a;
+        }
+        auto cliques = chordal_cliques(G, rows, pos);
+        for (const auto i : rows)
+        {
+            pos[i] = npos;
+        }
+
+        auto& checks = this->_checks.emplace_back();
+        if (cliques.size() > 1)
+        {
+            for (const auto& C : cliques)
+            {
+                checks.push_back(make_block(C, pos, F, B));
+            }
+        }
+        checks.push_back(make_block(rows, pos, F, B));
+        this->_work += nc * nc * nc;
+        for (auto& C : cliques)
+        {
+            this->_cliques.push_back(std::move(C));
+        }
+    }
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @return std::optional<Cut>
+ */
+std::optional<Cut> chordal_lmi_oracle::operator()(const Arr& x)
+{
+    auto cut = Cut {};
+    if (!(*this)(x, cut))
+    {
+        return {};
+    }
+    return {std::move(cut)};
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @param[out] cut
+ * @return bool
+ */
+auto chordal_lmi_oracle::operator()(const Arr& x, Cut& cut) -> bool
+{
+    constexpr auto parallel_work = size_t {1} << 18; // flops
+
+    auto assess = [&x](std::vector<sparse_lmi_oracle>& checks, Cut& c) {
+        return std::any_of(checks.begin(), checks.end(),
+            [&](auto& Omega) { return Omega(x, c); });
+    };
+
+    const auto N = this->_checks.size();
+    const auto n_threads = std::min<size_t>(
+        std::max(std::thread::hardware_concurrency(), 1U), N);
+    if (this->_work < parallel_work || n_threads < 2)
+    {
+        return std::any_of(this->_checks.begin(), this->_checks.end(),
+            [&](auto& checks) { return assess(checks, cut); });
+    }
+
+    // components are split among threads; those after the first
+    // violated one are skipped
+    auto first = std::atomic<size_t> {N};
+    auto cuts = std::vector<Cut>(N);
+    auto run = [&](size_t c0, size_t c1) {
+        for (auto c = c0; c != c1 && c < first.load(); ++c)
+        {
+            if (assess(this->_checks[c], cuts[c]))
+            {
+                auto f = first.load();
+                while (c < f && !first.compare_exchange_weak(f, c))
+                {
+                }
+                return;
+            }
+        }
+    };
+    auto tasks = std::vector<std::future<void>> {};
+    const auto chunk = (N + n_threads - 1) / n_threads;
+    for (auto c0 = chunk; c0 < N; c0 += chunk)
+    {
+        tasks.push_back(
+            std::async(std::launch::async, run, c0, std::min(c0 + chunk, N)));
+    }
+    run(0, std::min(chunk, N));
+    for (auto& task : tasks)
+    {
+        task.get();
+    }
+    if (first.load() == N)
+    {
+        return false;
+    }
+    cut = std::move(cuts[first.load()]);
+    return true;
+}
@@ -1,7 +1,10 @@
+#include <algorithm>
 #include <cmath>
 #include <ellcpp/cut_config.hpp>
 #include <ellcpp/ell.hpp>
 #include <ellcpp/ell_assert.hpp>
+#include <limits>
+#include <utility>
 #include <xtensor-blas/xlinalg.hpp>
 
 using Arr = xt::xarray<double, xt::layout_type::row_major>;
@@ -123,6 +126,83 @@ void ell::_calc_cc(const double& tau) noexcept
 }
 
 
+/*!
+ * @brief Points inside the ellipsoid along the columns of a pivoted
+ *        Cholesky factor of Q
+ *
+ * Only the columns u_j needed are formed, in O(n k^2), each pivoting on
+ * the largest diagonal left in Q - sum_j u_j u_j'. Since that remainder
+ * is positive semidefinite, u_j' Q^-1 u_j <= 1.
+ *
+ * @param[in] k
+ * @param[in] scale
+ * @return std::vector<Arr>
+ */
+auto ell::probe_points(size_t k, double scale) const -> std::vector<Arr>
+{
+    const auto n = size_t(this->_n);
+    auto points = std::vector<Arr> {};
+    points.reserve(std::min(k, 2 * n));
+
+    // u_j, in points[j]; a pivot already taken is left with rounding
+    // errors only
+    const auto eps = double(n) * std::numeric_limits<double>::epsilon();
+    while (points.size() != std::min((k + 1) / 2, n))
+    {
+        const auto j = points.size();
+        auto p = n;
+        auto d_max = 0.;
+        for (auto i = 0U; i != n; ++i)
+        {
+            auto d = this->_Q(i, i);
+            for (auto l = 0U; l != j; ++l)
+            {
+                d -= points[l](i) * points[l](i);
+            }
+            if (d > d_max && d > eps * this->_Q(i, i))
+            {
+                p = i;
+                d_max = d;
+            }
+        }
+        if (p == n)
+        { // Q is exhausted
+            break;
+        }
+        auto& u = points.emplace_back(this->_xc);
+        const auto s = 1. / std::sqrt(d_max);
+        for (auto i = 0U; i != n; ++i)
+        {
+            auto v = this->_Q(i, p);
+            for (auto l = 0U; l != j; ++l)
+            {
+                v -= points[l](i) * points[l](p);
+            }
+            u(i) = s * v;
+        }
+    }
+
+    // xc +- r u_j into points[2 j] and points[2 j + 1], from the last j
+    // down, so that every u_j is still in place when its turn comes
+    const auto r = scale * std::sqrt(this->_kappa);
+    const auto m = points.size();
+    points.resize(std::min(k, 2 * m));
+    for (auto j = m; j-- != 0;)
+    {
+        std::swap(points[j], points[2 * j]);
+        auto& x = points[2 * j];
+        if (2 * j + 1 != points.size())
+        {
+            points[2 * j + 1] = this->_xc - r * x;
+        }
+        for (auto i = 0U; i != n; ++i)
+        {
+            x(i) = this->_xc(i) + r * x(i);
+        }
+    }
+    return points;
+}
+
 /*!
  * @brief Update ellipsoid core function using the cut
  *
@@ -139,18 +219,52 @@ std::tuple<CUTStatus, double> ell::update(const std::tuple<Arr, T>& cut)
     const auto& beta = std::get<1>(cut);
 
     const auto& g = std::get<0>(cut);
-    // n^2
-    const auto Qg = Arr {xt::linalg::dot(this->_Q, g)}; // n^2
-    const auto omega = xt::linalg::dot(g, Qg)();        // n
+    if (this->_Qg.dimension() == 0)
+    {
+        this->_Qg = xt::zeros<double>({this->_n});
+    }
+    // n^2, into the scratch buffer
+    auto omega = 0.;
+    for (auto i = 0; i != this->_n; ++i)
+    {
+        auto s = 0.;
+        for (auto j = 0; j != this->_n; ++j)
+        {
+            s += this->_Q(i, j) * g(j);
+        }
+        this->_Qg(i) = s;
+        omega += g(i) * s; // n
+    }
+    const auto status = this->_update_core(this->_Qg, omega, beta);
+    return {status, this->_tsq}; // g++-7 is ok
+}
+
+/*!
+ * @brief Update xc and Q, given Q g and g' Q g
+ *
+ * @tparam T
+ * @param[in] Qg
+ * @param[in] omega
+ * @param[in] beta
+ * @return CUTStatus
+ */
+template <typename T>
+auto ell::_update_core(const Arr& Qg, const double& omega, const T& beta)
+    -> CUTStatus
+{
     this->_tsq = this->_kappa * omega;
 
     auto status = this->_update_cut(beta);
     if (status != CUTStatus::success)
     {
-        return {status, this->_tsq};
+        return status;
     }
 
-    this->_xc -= (this->_rho / omega) * Qg; // n
+    const auto rho = this->_rho / omega;
+    for (auto i = 0; i != this->_n; ++i)
+    {
+        this->_xc(i) -= rho * Qg(i); // n
+    }
     // n*(n+1)/2 + n
     // this->_Q -= (this->_sigma / omega) * xt::linalg::outer(Qg, Qg);
     const auto r = this->_sigma / omega;
@@ -172,7 +286,86 @@ std::tuple<CUTStatus, double> ell::update(const std::tuple<Arr, T>& cut)
         this->_Q *= this->_kappa;
         this->_kappa = 1.;
     }
-    return {status, this->_tsq}; // g++-7 is ok
+    return status;
+}
+
+/*!
+ * @brief Aggregated cut of the bounds violated by xc
+ *
+ * @param[out] g
+ * @param[out] beta
+ * @return bool
+ */
+auto ell::_bounds_cut(Arr& g, double& beta) const -> bool
+{
+    if (this->_lb.dimension() == 0)
+    {
+        return false; // no bounds
+    }
+    auto violated = false;
+    beta = 0.;
+    for (auto i = 0; i != this->_n; ++i)
+    {
+        if (this->_xc(i) > this->_ub(i))
+        {
+            if (!violated)
+            {
+                g = xt::zeros<double>({this->_n});
+                violated = true;
+            }
+            g(i) = 1.;
+            beta += this->_xc(i) - this->_ub(i);
+        }
+        else if (this->_xc(i) < this->_lb(i))
+        {
+            if (!violated)
+            {
+                g = xt::zeros<double>({this->_n});
+                violated = true;
+            }
+            g(i) = -1.;
+            beta += this->_lb(i) - this->_xc(i);
+        }
+    }
+    return violated;
+}
+
+/*!
+ * @brief Cut off the part of the ellipsoid outside the box
+ *
+ * @return CUTStatus
+ */
+auto ell::enforce_bounds() -> CUTStatus
+{
+    if (this->_lb.dimension() == 0)
+    {
+        return CUTStatus::noeffect; // no bounds, and no allocation
+    }
+    Arr g;
+    auto beta = 0.;
+    if (!this->_bounds_cut(g, beta))
+    {
+        return CUTStatus::noeffect;
+    }
+    // Q g from the columns of the violated bounds: n * (number of them)
+    auto Qg = Arr {xt::zeros<double>({this->_n})};
+    auto omega = 0.;
+    for (auto i = 0; i != this->_n; ++i)
+    {
+        if (g(i) == 0.)
+        {
+            continue;
+        }
+        for (auto j = 0; j != this->_n; ++j)
+        {
+            Qg(j) += g(i) * this->_Q(j, i);
+        }
+    }
+    for (auto i = 0; i != this->_n; ++i)
+    {
+        omega += g(i) * Qg(i);
+    }
+    return this->_update_core(Qg, omega, beta);
 }
 
 // Instantiation
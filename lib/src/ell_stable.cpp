@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 #include <ellcpp/cut_config.hpp>
 #include <ellcpp/ell_assert.hpp>
@@ -19,9 +20,17 @@ template <typename T>
 auto ell_stable::update(const std::tuple<Arr, T>& cut) -> std::tuple<CUTStatus, double>
 {
     const auto& [g, beta] = cut;
+    if (this->_gQg.dimension() == 0)
+    { // scratch, reused across updates
+        this->_invLg = xt::zeros<double>({this->_n});
+        this->_invDinvLg = xt::zeros<double>({this->_n});
+        this->_gQg = xt::zeros<double>({this->_n});
+        this->_Qg = xt::zeros<double>({this->_n});
+    }
 
     // calculate inv(L)*g: (n-1)*n/2 multiplications
-    auto invLg = Arr {g}; // initially
+    auto& invLg = this->_invLg;
+    std::copy(g.begin(), g.end(), invLg.begin()); // initially
     for (auto i = 1; i != this->_n; ++i)
     {
         for (auto j = 0; j != i; ++j)
@@ -33,18 +42,18 @@ auto ell_stable::update(const std::tuple<Arr, T>& cut) -> std::tuple<CUTStatus,
     }
 
     // calculate inv(D)*inv(L)*g: n
-    auto invDinvLg = Arr {invLg}; // initially
+    auto& invDinvLg = this->_invDinvLg;
     for (auto i = 0; i != this->_n; ++i)
     {
-        invDinvLg(i) *= this->_Q(i, i);
+        invDinvLg(i) = invLg(i) * this->_Q(i, i);
     }
 
     // calculate omega: n
-    auto gQg = Arr {invDinvLg}; // initially
-    auto omega = 0.;              // initially
+    auto& gQg = this->_gQg;
+    auto omega = 0.; // initially
     for (auto i = 0; i != this->_n; ++i)
     {
-        gQg(i) *= invLg(i);
+        gQg(i) = invDinvLg(i) * invLg(i);
         omega += gQg(i);
     }
 
@@ -57,7 +66,8 @@ auto ell_stable::update(const std::tuple<Arr, T>& cut) -> std::tuple<CUTStatus,
     }
 
     // calculate Q*g = inv(L')*inv(D)*inv(L)*g : (n-1)*n/2
-    auto Qg = Arr {invDinvLg}; // initially
+    auto& Qg = this->_Qg;
+    std::copy(invDinvLg.begin(), invDinvLg.end(), Qg.begin()); // initially
     for (auto i = this->_n - 1; i > 0; --i)
     { // backward subsituition
         for (auto j = i; j != this->_n; ++j)
@@ -67,7 +77,11 @@ auto ell_stable::update(const std::tuple<Arr, T>& cut) -> std::tuple<CUTStatus,
     }
 
     // calculate xc: n
-    this->_xc -= (this->_rho / omega) * Qg;
+    const auto rho = this->_rho / omega;
+    for (auto i = 0; i != this->_n; ++i)
+    {
+        this->_xc(i) -= rho * Qg(i);
+    }
 
     // rank-one update: 3*n + (n-1)*n/2
     // const auto r = this->_sigma / omega;
@@ -107,6 +121,26 @@ auto ell_stable::update(const std::tuple<Arr, T>& cut) -> std::tuple<CUTStatus,
     return {status, this->_tsq}; // g++-7 is ok
 }
 
+/*!
+ * @brief Cut off the part of the ellipsoid outside the box
+ *
+ * @return CUTStatus
+ */
+auto ell_stable::enforce_bounds() -> CUTStatus
+{
+    if (this->_lb.dimension() == 0)
+    {
+        return CUTStatus::noeffect; // no bounds, and no allocation
+    }
+    auto cut = std::tuple<Arr, double> {};
+    auto& [g, beta] = cut;
+    if (!this->_bounds_cut(g, beta))
+    {
+        return CUTStatus::noeffect;
+    }
+    return std::get<0>(this->update(cut));
+}
+
 // Instantiation
 template std::tuple<CUTStatus, double> ell_stable::update(
     const std::tuple<Arr, double>& cut);
@@ -0,0 +1,325 @@
+#include <algorithm>
+#include <cmath>
+#include <ellcpp/oracles/lanczos_lmi_oracle.hpp>
+#include <ellcpp/utility.hpp>
+
+using Arr = xt::xarray<double, xt::layout_type::row_major>;
+using Cut = std::tuple<Arr, double>;
+
+/*!
+ * @brief sum_i a_i b_i
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[in] len
+ * @return double
+ */
+static auto dot(const double* a, const double* b, size_t len) -> double
+{
+    auto res = 0.;
+    for (auto i = 0U; i != len; ++i)
+    {
+        res += a[i] * b[i];
+    }
+    return res;
+}
+
+/*!
+ * @brief Smallest eigenpair of a symmetric tridiagonal matrix (cyclic
+ *        Jacobi; the matrix is small)
+ *
+ * @param[in] alpha diagonal
+ * @param[in] beta off-diagonal, beta[i] couples i and i + 1
+ * @param[in] k dimension
+ * @param[out] s unit eigenvector
+ * @return double eigenvalue
+ */
+static auto min_eigenpair(const std::vector<double>& alpha,
+    const std::vector<double>& beta, size_t k, std::vector<double>& s)
+    -> double
+{
+    auto T = std::vector<double>(k * k, 0.);
+    auto Z = std::vector<double>(k * k, 0.);
+    auto norm2 = 0.;
+    for (auto i = 0U; i != k; ++i)
+    {
+        T[i * k + i] = alpha[i];
+        Z[i * k + i] = 1.;
+        norm2 += alpha[i] * alpha[i];
+        if (i + 1 != k)
+        {
+            T[i * k + i + 1] = T[(i + 1) * k + i] = beta[i];
+            norm2 += 2. * beta[i] * beta[i];
+        }
+    }
+
+    constexpr auto max_sweeps = 50;
+    for (auto sweep = 0; sweep != max_sweeps; ++sweep)
+    {
+        auto off = 0.;
+        for (auto p = 0U; p != k; ++p)
+        {
+            for (auto q = p + 1; q != k; ++q)
+            {
+                off += T[p * k + q] * T[p * k + q];
+            }
+        }
+        if (off <= 1e-30 * norm2)
+        {
+            break;
+        }
+        for (auto p = 0U; p != k; ++p)
+        {
+            for (auto q = p + 1; q != k; ++q)
+            {
+                const auto apq = T[p * k + q];
+                if (apq == 0.)
+                {
+                    continue;
+                }
+                const auto theta = (T[q * k + q] - T[p * k + p]) / (2. * apq);
+                const auto t = (theta >= 0. ? 1. : -1.)
+                    / (std::abs(theta) + std::sqrt(theta * theta + 1.));
+                const auto c = 1. / std::sqrt(t * t + 1.);
+                const auto sn = t * c;
+                for (auto r = 0U; r != k; ++r)
+                {
+                    const auto trp = T[r * k + p];
+                    const auto trq = T[r * k + q];
+                    T[r * k + p] = c * trp - sn * trq;
+                    T[r * k + q] = sn * trp + c * trq;
+                }
+                for (auto r = 0U; r != k; ++r)
+                {
+                    const auto tpr = T[p * k + r];
+                    const auto tqr = T[q * k + r];
+                    T[p * k + r] = c * tpr - sn * tqr;
+                    T[q * k + r] = sn * tpr + c * tqr;
+                }
+                for (auto r = 0U; r != k; ++r)
+                {
+                    const auto zrp = Z[r * k + p];
+                    const auto zrq = Z[r * k + q];
+                    Z[r * k + p] = c * zrp - sn * zrq;
+                    Z[r * k + q] = sn * zrp + c * zrq;
+                }
+            }
+        }
+    }
+
+    auto imin = size_t {0};
+    for (auto i = 1U; i != k; ++i)
+    {
+        if (T[i * k + i] < T[imin * k + imin])
+        {
+            imin = i;
+        }
+    }
+    s.resize(k);
+    for (auto r = 0U; r != k; ++r)
+    {
+        s[r] = Z[r * k + imin];
+    }
+    return T[imin * k + imin];
+}
+
+/*!
+ * @brief Construct a new lanczos lmi oracle object
+ *
+ * @param[in] m dimension
+ * @param[in] F
+ * @param[in] B
+ * @param[in] krylov_dim Lanczos steps per restart
+ * @param[in] max_restarts
+ */
+lanczos_lmi_oracle::lanczos_lmi_oracle(size_t m,
+    const std::vector<coo_matrix>& F, const coo_matrix& B, size_t krylov_dim,
+    size_t max_restarts)
+    : _m {m}
+    , _n {F.size()}
+    , _krylov_dim {std::max<size_t>(std::min(krylov_dim, m), 1U)}
+    , _max_restarts {max_restarts}
+    , _S {m, [&] {
+              auto FB = F;
+              FB.push_back(B);
+              return FB;
+          }()}
+    , _c {zeros({F.size() + 1})}
+    , _u {zeros({m})}
+    , _V {zeros({this->_krylov_dim, m})}
+    , _w {zeros({m})}
+    , _gx {zeros({F.size() + 1})}
+    , _Q {m}
+{
+    this->_c(this->_n) = 1.;
+    for (auto i = 0U; i != m; ++i)
+    {
+        // not orthogonal to any particular eigenvector
+        this->_u(i) = 1. + double((7U * i) % 11U) / 11.;
+    }
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @return std::optional<Cut>
+ */
+std::optional<Cut> lanczos_lmi_oracle::operator()(const Arr& x)
+{
+    auto cut = Cut {};
+    if (!(*this)(x, cut))
+    {
+        return {};
+    }
+    return {std::move(cut)};
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @param[out] cut
+ * @return bool
+ */
+auto lanczos_lmi_oracle::operator()(const Arr& x, Cut& cut) -> bool
+{
+    for (auto k = 0U; k != this->_n; ++k)
+    {
+        this->_c(k) = -x(k);
+    }
+    this->_theta = this->_lanczos();
+
+    auto& [g, ep] = cut;
+    if (this->_theta < 0.)
+    {
+        // v' A v, exactly
+        this->_cut(this->_u, {0U, this->_m}, cut);
+        auto vAv = this->_gx(this->_n);
+        for (auto k = 0U; k != this->_n; ++k)
+        {
+            vAv -= x(k) * this->_gx(k);
+        }
+        if (vAv < 0.)
+        {
+            ep = -vAv;
+            return true;
+        }
+    }
+
+    if (!this->_certify)
+    {
+        return false; // trust the Ritz value
+    }
+
+    // certify A >= 0, or fall back to the first failing pivot
+    auto getA = [this](size_t i, size_t j) -> double
+    { return this->_S.dot(i, j, this->_c); };
+
+    if (this->_Q.factor(getA))
+    {
+        return false;
+    }
+    ep = this->_Q.witness();
+    this->_cut(this->_Q.v, this->_Q.p, cut);
+    return true;
+}
+
+/*!
+ * @brief
+ *
+ * @return double
+ */
+auto lanczos_lmi_oracle::_lanczos() -> double
+{
+    const auto m = this->_m;
+    const auto k = this->_krylov_dim;
+    auto alpha = std::vector<double>(k);
+    auto beta = std::vector<double>(k);
+    auto s = std::vector<double> {};
+    auto* w = this->_w.data();
+    auto* u = this->_u.data();
+    auto theta = 0.;
+
+    for (auto restart = 0U; restart <= this->_max_restarts; ++restart)
+    {
+        const auto unorm = std::sqrt(dot(u, u, m));
+        auto* q0 = this->_V.data();
+        for (auto i = 0U; i != m; ++i)
+        {
+            q0[i] = u[i] / unorm;
+        }
+
+        auto len = k;
+        auto anorm = 0.;
+        for (auto j = 0U; j != k; ++j)
+        {
+            const auto* qj = this->_V.data() + j * m;
+            this->_S.sym_matvec(this->_c, qj, w);
+            alpha[j] = dot(qj, w, m);
+            // full reorthogonalization (twice is enough)
+            for (auto pass = 0; pass != 2; ++pass)
+            {
+                for (auto i = 0U; i <= j; ++i)
+                {
+                    const auto* qi = this->_V.data() + i * m;
+                    const auto h = dot(qi, w, m);
+                    for (auto r = 0U; r != m; ++r)
+                    {
+                        w[r] -= h * qi[r];
+                    }
+                }
+            }
+            beta[j] = std::sqrt(dot(w, w, m));
+            anorm = std::max(anorm,
+                std::abs(alpha[j]) + beta[j] + (j > 0 ? beta[j - 1] : 0.));
+            if (beta[j] <= 1e-12 * anorm) // invariant subspace
+            {
+                len = j + 1;
+                break;
+            }
+            if (j + 1 != k)
+            {
+                auto* qn = this->_V.data() + (j + 1) * m;
+                for (auto r = 0U; r != m; ++r)
+                {
+                    qn[r] = w[r] / beta[j];
+                }
+            }
+        }
+
+        theta = min_eigenpair(alpha, beta, len, s);
+        std::fill(u, u + m, 0.);
+        for (auto j = 0U; j != len; ++j)
+        {
+            const auto* qj = this->_V.data() + j * m;
+            for (auto r = 0U; r != m; ++r)
+            {
+                u[r] += s[j] * qj[r];
+            }
+        }
+
+        const auto residual = beta[len - 1] * std::abs(s[len - 1]);
+        if (residual <= 1e-8 * anorm)
+        {
+            break;
+        }
+    }
+    return theta;
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] v
+ * @param[in] p
+ * @param[out] cut
+ */
+void lanczos_lmi_oracle::_cut(
+    const Arr& v, const std::pair<size_t, size_t>& p, Cut& cut)
+{
+    auto& g = std::get<0>(cut);
+    this->_S.sym_quad(v, p, 1., this->_gx);
+    fill_zeros(g, this->_n);
+    std::copy(this->_gx.begin(), this->_gx.begin() + this->_n, g.begin());
+}
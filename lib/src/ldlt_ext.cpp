@@ -24,10 +24,10 @@ auto ldlt_ext::witness() -> double
         this->v(i - 1) = 0.;
         for (auto k = i; k != n; ++k)
         {
-            this->v(i - 1) -= this->T(k, i - 1) * this->v(k);
+            this->v(i - 1) -= this->_L(k)[i - 1] * this->v(k);
         }
     }
-    return -this->T(m, m);
+    return -this->_D()[m];
 }
 
 /*!
@@ -64,13 +64,14 @@ auto ldlt_ext::sqrt() -> Mat
 {
     assert(this->is_spd());
 
+    const auto* D = this->_D();
     auto M = zeros({this->n, this->n});
     for (auto i = 0U; i != this->n; ++i)
     {
-        M(i, i) = std::sqrt(this->T(i, i));
+        M(i, i) = std::sqrt(D[i]);
         for (auto j = i + 1; j != this->n; ++j)
         {
-            M(i, j) = this->T(j, i) * M(i, i);
+            M(i, j) = this->_L(j)[i] * M(i, i);
         }
     }
     return M;
@@ -12,28 +12,83 @@ using Cut = std::tuple<Arr, double>;
  * @return auto
  */
 std::optional<Cut> lmi0_oracle::operator()(const Arr& x)
+{
+    auto cut = Cut {};
+    if (!(*this)(x, cut))
+    {
+        return {};
+    }
+    return {std::move(cut)};
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @param[out] cut
+ * @return bool
+ */
+auto lmi0_oracle::operator()(const Arr& x, Cut& cut) -> bool
 {
     auto n = x.size();
 
-    auto getA = [&, this](size_t i, size_t j) -> double
-    {
-        auto a = 0.;
-        for (auto k = 0U; k != n; ++k)
+    auto getA = [&, this](size_t i, size_t j) -> double {
+        if (this->_adaptive)
         {
-            a += this->_F[k](i, j) * x(k);
+            std::tie(j, i) = std::minmax(this->_order[i], this->_order[j]);
         }
-        return a;
+        return detail::packed_dot(this->_Fc, i, j, x);
     };
 
-    if (this->_Q.factor(getA))
+    const auto spd = this->_mixed ? this->_Q.factor_mixed(getA)
+                                  : this->_Q.factor(getA);
+    if (spd)
     {
-        return {};
+        return false;
     }
-    auto ep = this->_Q.witness();
-    auto g = zeros(x);
-    for (auto i = 0U; i != n; ++i)
+    auto& [g, ep] = cut;
+    ep = this->_Q.witness();
+    fill_zeros(g, n);
+    if (this->_adaptive)
     {
-        g(i) = -_Q.sym_quad(this->_F[i]);
+        this->_order.update(this->_Q.v, this->_Q.p);
+        detail::packed_sym_quad(this->_Fc, this->_order.rows(),
+            this->_Q.v.data() + this->_Q.p.first, -1., g);
+        return true;
+    }
+    detail::packed_sym_quad(this->_Fc, this->_Q.v, this->_Q.p, -1., g);
+    return true;
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] X points, one per row
+ * @return std::vector<std::optional<Cut>>
+ */
+auto lmi0_oracle::evaluate_batch(const Arr& X)
+    -> std::vector<std::optional<Cut>>
+{
+    const auto FX = detail::assemble_lower(X, this->_Fc);
+    const auto n = X.shape()[1];
+
+    auto res = std::vector<std::optional<Cut>> {};
+    res.reserve(X.shape()[0]);
+    for (auto p = 0U; p != X.shape()[0]; ++p)
+    {
+        auto getA = [&](size_t i, size_t j) -> double
+        { return FX(p, i * (i + 1) / 2 + j); };
+
+        if (this->_Q.factor(getA))
+        {
+            res.emplace_back();
+            continue;
+        }
+        const auto ep = this->_Q.witness();
+        auto g = zeros({n});
+        detail::packed_sym_quad(
+            this->_Fc, this->_Q.v, this->_Q.p, -1., g);
+        res.emplace_back(Cut {std::move(g), ep});
     }
-    return {{std::move(g), ep}};
+    return res;
 }
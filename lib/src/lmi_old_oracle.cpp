@@ -13,24 +13,51 @@ using Cut = std::tuple<Arr, double>;
  * @return std::optional<Cut>
  */
 std::optional<Cut> lmi_old_oracle::operator()(const Arr& x)
+{
+    auto cut = Cut {};
+    if (!(*this)(x, cut))
+    {
+        return {};
+    }
+    return {std::move(cut)};
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @param[out] cut
+ * @return bool
+ */
+auto lmi_old_oracle::operator()(const Arr& x, Cut& cut) -> bool
 {
     const auto n = x.size();
+    const auto m = this->_F0.shape()[0];
 
-    auto A = Arr {this->_F0};
+    auto& A = this->_A;
+    A = this->_F0; // same shape: no allocation
     for (auto k = 0U; k != n; ++k)
     {
-        A -= this->_F[k] * x(k);
+        const auto& Fk = this->_F[k];
+        for (auto i = 0U; i != m; ++i)
+        {
+            for (auto j = 0U; j != m; ++j)
+            {
+                A(i, j) -= Fk(i, j) * x(k);
+            }
+        }
     }
 
     if (this->_Q.factorize(A))
     {
-        return {};
+        return false;
     }
-    const auto ep = this->_Q.witness();
-    auto g = zeros(x);
+    auto& [g, ep] = cut;
+    ep = this->_Q.witness();
+    fill_zeros(g, n);
     for (auto i = 0U; i != n; ++i)
     {
         g(i) = this->_Q.sym_quad(this->_F[i]);
     }
-    return {{std::move(g), ep}};
+    return true;
 }
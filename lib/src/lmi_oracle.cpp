@@ -1,5 +1,6 @@
 #include <ellcpp/oracles/lmi_oracle.hpp>
 #include <ellcpp/utility.hpp>
+#include <xtensor/xview.hpp>
 // #include <xtensor-blas/xlinalg.hpp>
 
 using Arr = xt::xarray<double, xt::layout_type::row_major>;
@@ -12,28 +13,101 @@ using Cut = std::tuple<Arr, double>;
  * @return std::optional<Cut>
  */
 std::optional<Cut> lmi_oracle::operator()(const Arr& x)
+{
+    auto cut = Cut {};
+    if (!(*this)(x, cut))
+    {
+        return {};
+    }
+    return {std::move(cut)};
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @param[out] cut
+ * @return bool
+ */
+auto lmi_oracle::operator()(const Arr& x, Cut& cut) -> bool
 {
     const auto n = x.size();
+    const auto nd = this->_Fc.shape()[1];
 
-    auto getA = [&, this](size_t i, size_t j) -> double
-    {
-        auto a = this->_F0(i, j);
-        for (auto k = 0U; k != n; ++k)
+    this->_L.scale(x.data() + nd);
+
+    auto getA = [&, this](size_t i, size_t j) -> double {
+        if (this->_adaptive)
         {
-            a -= this->_F[k](i, j) * x(k);
+            std::tie(j, i) = std::minmax(this->_order[i], this->_order[j]);
         }
-        return a;
+        return this->_F0(i, j) - detail::packed_dot(this->_Fc, i, j, x)
+            - this->_L.entry(i, j);
     };
 
-    if (this->_Q.factor(getA))
+    const auto spd = this->_mixed ? this->_Q.factor_mixed(getA)
+                                  : this->_Q.factor(getA);
+    if (spd)
     {
-        return {};
+        return false;
+    }
+    auto& [g, ep] = cut;
+    ep = this->_Q.witness();
+    fill_zeros(g, n);
+    if (this->_adaptive)
+    {
+        this->_order.update(this->_Q.v, this->_Q.p);
+        const auto* w = this->_Q.v.data() + this->_Q.p.first;
+        const auto& rows = this->_order.rows();
+        detail::packed_sym_quad(this->_Fc, rows, w, 1., g);
+        this->_L.sym_quad(rows, w, 1., g.data() + nd);
+        return true;
     }
-    auto ep = this->_Q.witness();
-    auto g = zeros(x);
-    for (auto i = 0U; i != n; ++i)
+    detail::packed_sym_quad(this->_Fc, this->_Q.v, this->_Q.p, 1., g);
+    this->_L.sym_quad(this->_Q.v, this->_Q.p, 1., g.data() + nd);
+    return true;
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] X points, one per row
+ * @return std::vector<std::optional<Cut>>
+ */
+auto lmi_oracle::evaluate_batch(const Arr& X)
+    -> std::vector<std::optional<Cut>>
+{
+    if (!this->_L.empty())
+    {
+        auto res = std::vector<std::optional<Cut>> {};
+        res.reserve(X.shape()[0]);
+        for (auto p = 0U; p != X.shape()[0]; ++p)
+        {
+            res.push_back((*this)(Arr {xt::view(X, p, xt::all())}));
+        }
+        return res;
+    }
+
+    const auto FX = detail::assemble_lower(X, this->_Fc);
+    const auto n = X.shape()[1];
+
+    auto res = std::vector<std::optional<Cut>> {};
+    res.reserve(X.shape()[0]);
+    for (auto p = 0U; p != X.shape()[0]; ++p)
     {
-        g(i) = this->_Q.sym_quad(this->_F[i]);
+        auto getA = [&, this](size_t i, size_t j) -> double
+        { return this->_F0(i, j) - FX(p, i * (i + 1) / 2 + j); };
+
+        if (this->_Q.factor(getA))
+        {
+            res.emplace_back();
+            continue;
+        }
+        const auto ep = this->_Q.witness();
+        auto g = zeros({n});
+        detail::packed_sym_quad(
+            this->_Fc, this->_Q.v, this->_Q.p, 1., g);
+        res.emplace_back(Cut {std::move(g), ep});
     }
-    return {{std::move(g), ep}};
+    return res;
 }
@@ -1,32 +1,99 @@
+#include <cmath>
 #include <ellcpp/oracles/lowpass_oracle.hpp>
 #include <ellcpp/utility.hpp>
-#include <xtensor-blas/xlinalg.hpp>
 
 using Arr = xt::xarray<double, xt::layout_type::row_major>;
 using ParallelCut = std::tuple<Arr, Arr>;
 
 /*!
- * @brief
+ * @brief Row k of A times x
  *
+ * @param[in] A
+ * @param[in] k
  * @param[in] x
- * @param[in] Spsq
- * @return auto
+ * @return double
  */
-auto lowpass_oracle::operator()(const Arr& x, double& Spsq) const
-    -> std::tuple<ParallelCut, bool>
+static auto row_dot(const Arr& A, size_t k, const Arr& x) -> double
 {
-    using xt::linalg::dot;
+    auto res = 0.;
+    for (auto j = 0U; j != x.size(); ++j)
+    {
+        res += A(k, j) * x(j);
+    }
+    return res;
+}
+
+/*!
+ * @brief g = s * (row k of A)
+ *
+ * @param[out] g
+ * @param[in] A
+ * @param[in] k
+ * @param[in] s
+ */
+static void set_row(Arr& g, const Arr& A, size_t k, double s)
+{
+    for (auto j = 0U; j != g.size(); ++j)
+    {
+        g(j) = s * A(k, j);
+    }
+}
+
+/*!
+ * @brief The cut as a plain parallel cut: beta1 = +inf is dropped
+ *
+ * @param[in] cut
+ * @return ParallelCut
+ */
+static auto single_if_inf(ParallelCut cut) -> ParallelCut
+{
+    auto& f = std::get<1>(cut);
+    if (std::isinf(f(1)))
+    {
+        f = Arr {f(0)}; // single cut
+    }
+    return cut;
+}
+
+/*!
+ * @brief Assess x, handing every violated constraint to emit in turn
+ *
+ *    The constraints are visited round robin from where the previous call
+ *    stopped. Each violated one is written into the buffer and passed to
+ *    emit, which returns true to stop there. Only then is the round-robin
+ *    position moved past it: the rows that emit lets go by do not count.
+ *    The objective cut is left in the buffer only if no constraint is
+ *    violated.
+ *
+ * @tparam Emit callable (const ParallelCut&) -> bool
+ * @param[in] x
+ * @param[in,out] Spsq
+ * @param[out] cut
+ * @param[in] emit
+ * @return true if Spsq is shrunk
+ */
+template <typename Emit>
+auto lowpass_oracle::_assess(
+    const Arr& x, double& Spsq, ParallelCut& cut, Emit&& emit) const -> bool
+{
+    constexpr auto inf = std::numeric_limits<double>::infinity();
+    auto& [g, f] = cut;
+    fill_zeros(g, x.size());
+    fill_zeros(f, 2U);
 
     // 1. nonnegative-real constraint
     // case 1,
     if (x[0] < 0)
     {
-        auto g = zeros(x);
         g[0] = -1.;
-        auto f = Arr {-x[0]};
-        return {{std::move(g), std::move(f)}, false};
+        f(0) = -x[0];
+        f(1) = inf;
+        emit(cut);
+        return false;
     }
 
+    auto violated = false;
+
     // case 2,
     // 2. passband constraints
     auto N = this->_Ap.shape()[0];
@@ -39,29 +106,38 @@ auto lowpass_oracle::operator()(const Arr& x, double& Spsq) const
         {
             k = 0; // round robin
         }
-        auto v = dot(xt::view(this->_Ap, k, xt::all()), x)();
+        auto v = row_dot(this->_Ap, k, x);
         if (v > this->_Upsq)
         {
             // f = v - Upsq;
-            Arr g = xt::view(this->_Ap, k, xt::all());
-            Arr f {v - this->_Upsq, v - this->_Lpsq};
-            this->_i_Ap = k + 1;
-            return {{std::move(g), std::move(f)}, false};
+            set_row(g, this->_Ap, k, 1.);
+            f(0) = v - this->_Upsq;
+            f(1) = v - this->_Lpsq;
+            violated = true;
+            if (emit(cut))
+            {
+                this->_i_Ap = k + 1;
+                return false;
+            }
         }
-        if (v < this->_Lpsq)
+        else if (v < this->_Lpsq)
         {
             // f = Lpsq - v;
-            Arr g = -xt::view(this->_Ap, k, xt::all());
-            Arr f {-v + this->_Lpsq, -v + this->_Upsq};
-            this->_i_Ap = k + 1;
-            return {{std::move(g), std::move(f)}, false};
+            set_row(g, this->_Ap, k, -1.);
+            f(0) = -v + this->_Lpsq;
+            f(1) = -v + this->_Upsq;
+            violated = true;
+            if (emit(cut))
+            {
+                this->_i_Ap = k + 1;
+                return false;
+            }
         }
     }
 
     // case 3,
     // 3. stopband constraint
     N = this->_As.shape()[0];
-    // Arr w = xt::zeros<double>({N});
     auto fmax = -1.e100; // std::numeric_limits<double>::min()
     size_t imax {0};
     // for (k in chain(range(i_As, N), range(i_As))) {
@@ -72,25 +148,33 @@ auto lowpass_oracle::operator()(const Arr& x, double& Spsq) const
         {
             k = 0; // round robin
         }
-        auto v = dot(xt::view(this->_As, k, xt::all()), x)();
+        auto v = row_dot(this->_As, k, x);
         if (v > Spsq)
         {
-            // f = v - Spsq;
-            Arr g = xt::view(this->_As, k, xt::all());
             // f = (v - Spsq, v);
-            Arr f {v - Spsq, v};
-            this->_i_As = k + 1; // k or k+1
-            return {{std::move(g), std::move(f)}, false};
+            set_row(g, this->_As, k, 1.);
+            f(0) = v - Spsq;
+            f(1) = v;
+            violated = true;
+            if (emit(cut))
+            {
+                this->_i_As = k + 1; // k or k+1
+                return false;
+            }
         }
-        if (v < 0)
+        else if (v < 0)
         {
-            // f = v - Spsq;
-            Arr g = -xt::view(this->_As, k, xt::all());
-            Arr f {-v, -v + Spsq};
-            this->_i_As = k + 1;
-            return {{std::move(g), std::move(f)}, false};
+            set_row(g, this->_As, k, -1.);
+            f(0) = -v;
+            f(1) = -v + Spsq;
+            violated = true;
+            if (emit(cut))
+            {
+                this->_i_As = k + 1;
+                return false;
+            }
         }
-        if (v > fmax)
+        else if (v > fmax)
         {
             fmax = v;
             imax = k;
@@ -107,21 +191,90 @@ auto lowpass_oracle::operator()(const Arr& x, double& Spsq) const
         {
             k = 0; // round robin
         }
-        auto v = dot(xt::view(this->_Anr, k, xt::all()), x)();
+        auto v = row_dot(this->_Anr, k, x);
         if (v < 0.)
         {
-            Arr f {-v};
-            Arr g = -xt::view(this->_Anr, k, xt::all());
-            this->_i_Anr = k + 1;
-            return {{std::move(g), std::move(f)}, false};
+            set_row(g, this->_Anr, k, -1.);
+            f(0) = -v;
+            f(1) = inf;
+            violated = true;
+            if (emit(cut))
+            {
+                this->_i_Anr = k + 1;
+                return false;
+            }
         }
     }
 
+    if (violated)
+    {
+        return false;
+    }
+
     // Begin objective function
     // Spsq, imax = w.max(), w.argmax(); // update best so far Spsq
     Spsq = fmax;
-    Arr f {0., fmax}; // ???
-    // f = 0
-    Arr g = xt::view(this->_As, imax, xt::all());
-    return {{std::move(g), std::move(f)}, true};
+    set_row(g, this->_As, imax, 1.);
+    f(0) = 0.; // ???
+    f(1) = fmax;
+    return true;
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @param[in] Spsq
+ * @return auto
+ */
+auto lowpass_oracle::operator()(const Arr& x, double& Spsq) const
+    -> std::tuple<ParallelCut, bool>
+{
+    auto cut = ParallelCut {};
+    const auto shrunk = (*this)(x, Spsq, cut);
+    return {single_if_inf(std::move(cut)), shrunk};
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @param[in,out] Spsq
+ * @param[out] cut
+ * @return bool
+ */
+auto lowpass_oracle::operator()(
+    const Arr& x, double& Spsq, ParallelCut& cut) const -> bool
+{
+    return this->_assess(
+        x, Spsq, cut, [](const ParallelCut& /* cut */) { return true; });
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @param[in] Spsq
+ * @return cut_generator<std::tuple<ParallelCut, bool>>
+ */
+auto lowpass_oracle::generate(const Arr& x, double& Spsq) const
+    -> cut_generator<std::tuple<ParallelCut, bool>>
+{
+    using Elem = std::tuple<ParallelCut, bool>;
+
+    return cut_generator<Elem>(cut_stack {this->_stack},
+        [this, &x, &Spsq](cut_yield<Elem>& yield)
+        {
+            auto cut = ParallelCut {};
+            const auto shrunk = this->_assess(x, Spsq, cut,
+                [&yield](const ParallelCut& c)
+                {
+                    yield({single_if_inf(c), false});
+                    return false; // keep going
+                });
+            if (shrunk)
+            {
+                yield({std::move(cut), true});
+            }
+        });
 }
@@ -156,7 +156,7 @@ class lsq_oracle
      */
     lsq_oracle(const std::vector<Arr>& F, const Arr& F0)
         : _qmi(F, F0)
-        , _lmi0(F)
+        , _lmi0(F, _qmi._Q.workspace()) // evaluated one after another
     {
     }
 
@@ -271,7 +271,7 @@ class mle_oracle
         : _Y {Y}
         , _Sig {Sig}
         , _lmi0(Sig)
-        , _lmi(Sig, 2 * Y)
+        , _lmi(Sig, 2 * Y, _lmi0._Q.workspace()) // evaluated in turn
     {
     }
 
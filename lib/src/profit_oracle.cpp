@@ -1,5 +1,6 @@
+#include <cmath>
 #include <ellcpp/oracles/profit_oracle.hpp>
-#include <xtensor-blas/xlinalg.hpp>
+#include <ellcpp/utility.hpp>
 
 using Arr = xt::xarray<double, xt::layout_type::row_major>;
 using Cut = std::tuple<Arr, double>;
@@ -14,28 +15,79 @@ using Cut = std::tuple<Arr, double>;
 auto profit_oracle::operator()(const Arr& y, double& t) const
     -> std::tuple<Cut, bool>
 {
+    auto cut = Cut {};
+    const auto shrunk = (*this)(y, t, cut);
+    return {std::move(cut), shrunk};
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] y
+ * @param[in,out] t the best-so-far optimal value
+ * @param[out] cut
+ * @return bool
+ */
+auto profit_oracle::operator()(const Arr& y, double& t, Cut& cut) const
+    -> bool
+{
+    auto& [g, beta] = cut;
+    const auto n = y.size();
+    fill_zeros(g, n);
+
     // y0 <= log k
     const auto f1 = y[0] - this->_log_k;
     if (f1 > 0.)
     {
-        return {{Arr {1., 0.}, f1}, false};
+        g[0] = 1.;
+        beta = f1;
+        return false;
     }
 
-    const auto log_Cobb = this->_log_pA + xt::linalg::dot(this->_a, y)();
-    const auto x = Arr {xt::exp(y)};
-    const auto vx = xt::linalg::dot(this->_v, x)();
+    auto ay = 0.;
+    auto vx = 0.;
+    for (auto i = 0U; i != n; ++i)
+    {
+        ay += this->_a[i] * y[i];
+        vx += this->_v[i] * std::exp(y[i]);
+    }
+    const auto log_Cobb = this->_log_pA + ay;
     auto te = t + vx;
 
     auto fj = std::log(te) - log_Cobb;
+    auto shrunk = false;
     if (fj < 0.)
     {
         te = std::exp(log_Cobb);
         t = te - vx;
-        auto g = Arr {(this->_v * x) / te - this->_a};
-        return {{std::move(g), 0.}, true};
+        fj = 0.;
+        shrunk = true;
     }
-    auto g = Arr {(this->_v * x) / te - this->_a};
-    return {{std::move(g), fj}, false};
+    for (auto i = 0U; i != n; ++i)
+    {
+        g[i] = this->_v[i] * std::exp(y[i]) / te - this->_a[i];
+    }
+    beta = fj;
+    return shrunk;
+}
+
+/*!
+ * @param[in] y
+ * @return const Arr&
+ */
+auto profit_q_oracle::discretize(const Arr& y) -> const Arr&
+{
+    fill_zeros(this->_yd, y.size());
+    for (auto i = 0U; i != y.size(); ++i)
+    {
+        auto x = std::round(std::exp(y[i]));
+        if (x == 0.)
+        {
+            x = 1.; // nearest integer than 0
+        }
+        this->_yd[i] = std::log(x);
+    }
+    return this->_yd;
 }
 
 /*!
@@ -45,22 +97,31 @@ auto profit_oracle::operator()(const Arr& y, double& t) const
  */
 std::tuple<Cut, Arr, bool, bool> profit_q_oracle::operator()(
     const Arr& y, double& t, bool retry)
+{
+    auto cut = Cut {};
+    const auto [yd, shrunk, more] = (*this)(y, t, retry, cut);
+    return {std::move(cut), yd, shrunk, more};
+}
+
+/*!
+ * @param[in] y
+ * @param[in,out] t the best-so-far optimal value
+ * @param[in] retry
+ * @param[out] cut
+ * @return std::tuple<const Arr&, bool, bool>
+ */
+auto profit_q_oracle::operator()(const Arr& y, double& t, bool retry,
+    Cut& cut) -> std::tuple<const Arr&, bool, bool>
 {
     if (!retry)
     {
-        auto x = Arr {xt::round(xt::exp(y))};
-        if (x[0] == 0.)
-        {
-            x[0] = 1.; // nearest integer than 0
-        }
-        if (x[1] == 0.)
-        {
-            x[1] = 1.;
-        }
-        this->_yd = xt::log(x);
+        this->discretize(y);
     }
-    auto [cut, shrunk] = this->_P(this->_yd, t);
+    const auto shrunk = this->_P(this->_yd, t, cut);
     auto& [g, h] = cut;
-    h += xt::linalg::dot(g, this->_yd - y)();
-    return {std::move(cut), this->_yd, shrunk, !retry};
+    for (auto i = 0U; i != y.size(); ++i)
+    {
+        h += g[i] * (this->_yd[i] - y[i]);
+    }
+    return {this->_yd, shrunk, !retry};
 }
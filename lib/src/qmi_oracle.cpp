@@ -1,9 +1,9 @@
 #include <cassert>
 #include <ellcpp/oracles/qmi_oracle.hpp>
+#include <ellcpp/utility.hpp>
 #include <xtensor-blas/xlinalg.hpp>
 
 #define ROW(X, index) xt::view(X, index, xt::all())
-#define COLUMN(X, index) xt::view(X, xt::all(), index)
 
 using Arr = xt::xarray<double, xt::layout_type::row_major>;
 using Cut = std::tuple<Arr, double>;
@@ -16,23 +16,109 @@ using Cut = std::tuple<Arr, double>;
  */
 std::optional<Cut> qmi_oracle::operator()(const Arr& x)
 {
-    using xt::linalg::dot;
+    auto cut = Cut {};
+    if (!(*this)(x, cut))
+    {
+        return {};
+    }
+    return {std::move(cut)};
+}
 
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @param[out] cut
+ * @return bool
+ */
+auto qmi_oracle::operator()(const Arr& x, Cut& cut) -> bool
+{
     this->_count = 0;
     this->_nx = x.shape()[0];
+    return this->_assess(x, cut);
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] X points, one per row
+ * @return std::vector<std::optional<Cut>>
+ */
+auto qmi_oracle::evaluate_batch(const Arr& X)
+    -> std::vector<std::optional<Cut>>
+{
+    if (this->_Fs.dimension() == 0)
+    {
+        this->_Fs = detail::stack(this->_F, true);
+    }
+    const auto FX = detail::assemble(X, this->_Fs);
+    this->_nx = X.shape()[1];
+
+    auto res = std::vector<std::optional<Cut>> {};
+    res.reserve(X.shape()[0]);
+    for (auto p = 0U; p != X.shape()[0]; ++p)
+    {
+        for (auto i = 0U; i != this->_m; ++i)
+        {
+            for (auto l = 0U; l != this->_n; ++l)
+            {
+                this->_Fx(i, l) = this->_F0(l, i) - FX(p, i * this->_n + l);
+            }
+        }
+        this->_count = this->_m; // all rows of _Fx are ready
+        auto cut = Cut {};
+        if (this->_assess(Arr {ROW(X, p)}, cut))
+        {
+            res.emplace_back(std::move(cut));
+        }
+        else
+        {
+            res.emplace_back();
+        }
+    }
+    return res;
+}
 
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @param[in] i
+ */
+void qmi_oracle::_form_row(const Arr& x, size_t i)
+{
+    for (auto l = 0U; l != this->_n; ++l)
+    {
+        auto a = this->_F0(l, i);
+        for (auto k = 0U; k != this->_nx; ++k)
+        {
+            a -= this->_F[k](l, i) * x(k);
+        }
+        this->_Fx(i, l) = a;
+    }
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @param[out] cut
+ * @return bool
+ */
+auto qmi_oracle::_assess(const Arr& x, Cut& cut) -> bool
+{
     auto getA = [&, this](size_t i, size_t j) -> double { // ???
         assert(i >= j);
         if (this->_count < i + 1)
         {
             this->_count = i + 1;
-            ROW(this->_Fx, i) = COLUMN(this->_F0, i);
-            for (auto k = 0U; k != this->_nx; ++k)
-            {
-                ROW(this->_Fx, i) -= COLUMN(this->_F[k], i) * x(k);
-            }
+            this->_form_row(x, i);
+        }
+        auto a = 0.;
+        for (auto l = 0U; l != this->_n; ++l)
+        {
+            a -= this->_Fx(i, l) * this->_Fx(j, l);
         }
-        auto a = -dot(ROW(this->_Fx, i), ROW(this->_Fx, j))();
         if (i == j)
         {
             a += this->_t;
@@ -42,19 +128,39 @@ std::optional<Cut> qmi_oracle::operator()(const Arr& x)
 
     if (this->_Q.factor(getA))
     {
-        return {};
+        return false;
     }
 
-    const auto ep = this->_Q.witness();
+    auto& [g, ep] = cut;
+    ep = this->_Q.witness();
     const auto [start, stop] = this->_Q.p;
-    const auto v = xt::view(this->_Q.v, xt::range(start, stop));
-    const auto Fxp = ROW(this->_Fx, xt::range(start, stop));
-    const auto Av = dot(v, Fxp);
-    auto g = zeros({this->_nx});
+    const auto& v = this->_Q.v;
+
+    // Av = v' F(x)(p, :), then g_k = -2 v' F_k(p, :) Av
+    for (auto l = 0U; l != this->_n; ++l)
+    {
+        auto s = 0.;
+        for (auto r = start; r != stop; ++r)
+        {
+            s += v(r) * this->_Fx(r, l);
+        }
+        this->_Av(l) = s;
+    }
+    fill_zeros(g, this->_nx);
     for (auto k = 0U; k != this->_nx; ++k)
     {
-        const auto Fkp = ROW(this->_F[k], xt::range(start, stop));
-        g(k) = -2 * dot(dot(v, Fkp), Av)();
+        const auto& Fk = this->_F[k];
+        auto s = 0.;
+        for (auto l = 0U; l != this->_n; ++l)
+        {
+            auto vFk = 0.;
+            for (auto r = start; r != stop; ++r)
+            {
+                vFk += v(r) * Fk(r, l);
+            }
+            s += vFk * this->_Av(l);
+        }
+        g(k) = -2. * s;
     }
-    return {{std::move(g), ep}};
+    return true;
 }
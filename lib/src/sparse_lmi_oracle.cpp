@@ -0,0 +1,47 @@
+#include <ellcpp/oracles/sparse_lmi_oracle.hpp>
+#include <ellcpp/utility.hpp>
+
+using Arr = xt::xarray<double, xt::layout_type::row_major>;
+using Cut = std::tuple<Arr, double>;
+
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @return std::optional<Cut>
+ */
+std::optional<Cut> sparse_lmi_oracle::operator()(const Arr& x)
+{
+    auto cut = Cut {};
+    if (!(*this)(x, cut))
+    {
+        return {};
+    }
+    return {std::move(cut)};
+}
+
+/*!
+ * @brief
+ *
+ * @param[in] x
+ * @param[out] cut
+ * @return bool
+ */
+auto sparse_lmi_oracle::operator()(const Arr& x, Cut& cut) -> bool
+{
+    const auto n = x.size();
+
+    auto getA = [&, this](size_t i, size_t j) -> double
+    { return this->_F0(i, j) - this->_F.dot(i, j, x); };
+
+    if (this->_Q.factor(getA))
+    {
+        return false;
+    }
+    auto& [g, ep] = cut;
+    ep = this->_Q.witness();
+    fill_zeros(g, n);
+    this->_F.sym_quad(this->_Q.v, this->_Q.p, 1., g);
+    return true;
+}
+
@@ -1,3 +1,4 @@
+#include <cmath>
 #include <doctest/doctest.h>
 #include <ellcpp/oracles/ldlt_ext.hpp>
 // #include <xtensor/xarray.hpp>
@@ -31,3 +32,108 @@ TEST_CASE("Cholesky test 3")
     // CHECK(Q3.p.second == 1);
     CHECK(ep3 == 0.);
 }
+
+TEST_CASE("Cholesky test 4")
+{
+    // A = m I - 1 1': its leading k x k block has the eigenvalue m - k,
+    // so the factorization stops at row 23 (size not a multiple of 4)
+    constexpr auto n = 37U;
+    constexpr auto m = 22.5;
+    auto getA = [&](size_t i, size_t j) { return (i == j ? m : 0.) - 1.; };
+    auto Q4 = ldlt_ext(n);
+    Q4.factor(getA);
+    CHECK(!Q4.is_spd());
+    CHECK(Q4.p.second == 23U);
+    const auto ep4 = Q4.witness();
+    CHECK(ep4 >= 0.);
+
+    auto A = Arr {xt::zeros<double>({n, n})};
+    for (auto i = 0U; i != n; ++i)
+    {
+        for (auto j = 0U; j != n; ++j)
+        {
+            A(i, j) = getA(i, j);
+        }
+    }
+    CHECK(Q4.sym_quad(A) == doctest::Approx(-ep4));
+}
+
+TEST_CASE("Cholesky test (shared workspace)")
+{
+    const auto m1 = Arr {{25., 15., -5.}, {15., 18., 0.}, {-5., 0., 11.}};
+    const auto m2 = Arr {{18., 22., 54., 42.}, {22., -70., 86., 62.},
+        {54., 86., -174., 134.}, {42., 62., 134., -106.}};
+    auto Q1 = ldlt_ext(m1.shape()[0]);
+    auto Q2 = ldlt_ext(m2.shape()[0], Q1.workspace());
+    CHECK(Q1.workspace() == Q2.workspace());
+
+    // used one after another
+    CHECK(!Q2.factorize(m2));
+    const auto ep2 = Q2.witness();
+    CHECK(Q2.sym_quad(m2) == doctest::Approx(-ep2));
+    CHECK(Q1.factorize(m1));
+    const auto R = Q1.sqrt();
+    for (auto i = 0U; i != 3U; ++i)
+    {
+        for (auto j = 0U; j != 3U; ++j)
+        {
+            auto a = 0.;
+            for (auto k = 0U; k != 3U; ++k)
+            {
+                a += R(k, i) * R(k, j);
+            }
+            CHECK(a == doctest::Approx(m1(i, j)));
+        }
+    }
+}
+
+TEST_CASE("Cholesky test (mixed precision)")
+{
+    auto to_dense = [](size_t n, auto&& getA) {
+        auto A = Arr {xt::zeros<double>({n, n})};
+        for (auto i = 0U; i != n; ++i)
+        {
+            for (auto j = 0U; j != n; ++j)
+            {
+                A(i, j) = getA(i, j);
+            }
+        }
+        return A;
+    };
+
+    // tridiag(-1, 2, -1) - sigma I is positive definite iff
+    // sigma < lambda = 2 - 2 cos(pi / (n + 1)), cond ~ 1500
+    constexpr auto n = 60U;
+    const auto lambda = 2. - 2. * std::cos(std::acos(-1.) / (n + 1));
+    auto Q = ldlt_ext(n);
+    for (auto delta : {0.5, 1e-2, 1e-4, 1e-6})
+    {
+        for (auto sign : {-1., 1.})
+        {
+            const auto sigma = lambda * (1. + sign * delta);
+            auto getA = [&](size_t i, size_t j) {
+                return i == j ? 2. - sigma
+                              : (i == j + 1 || j == i + 1 ? -1. : 0.);
+            };
+            CHECK(Q.factor_mixed(getA) == (sign < 0.));
+            if (!Q.is_spd())
+            {
+                const auto ep = Q.witness();
+                CHECK(ep > 0.);
+                CHECK(Q.sym_quad(to_dense(n, getA))
+                    == doctest::Approx(-ep).epsilon(1e-10));
+            }
+        }
+    }
+
+    // m I - 1 1': same rows as in double, also at the singular edge
+    constexpr auto n4 = 37U;
+    auto Q4 = ldlt_ext(n4);
+    auto Q4d = ldlt_ext(n4);
+    for (auto m : {22.5, 23., 23. + 1e-6, 40.})
+    {
+        auto getA = [&](size_t i, size_t j) { return (i == j ? m : 0.) - 1.; };
+        CHECK(Q4.factor_mixed(getA) == Q4d.factor(getA));
+        CHECK(Q4.p == Q4d.p);
+    }
+}
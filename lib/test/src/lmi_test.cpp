@@ -1,17 +1,36 @@
 /*
  *  Distributed under the MIT License (See accompanying file /LICENSE )
  */
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <doctest/doctest.h>
+#include <ellcpp/accpm.hpp>
 #include <ellcpp/cutting_plane.hpp>
+#include <ellcpp/cutting_plane_probe.hpp>
 #include <ellcpp/ell.hpp>
 #include <ellcpp/ell_stable.hpp>
+#include <ellcpp/oracles/chordal_lmi_oracle.hpp>
+#include <ellcpp/oracles/composite_oracle.hpp>
+#include <ellcpp/oracles/cut_pool.hpp>
+#include <ellcpp/oracles/lanczos_lmi_oracle.hpp>
+#include <ellcpp/oracles/lmi0_oracle.hpp>
 #include <ellcpp/oracles/lmi_oracle.hpp>
+#include <ellcpp/oracles/low_rank_matrices.hpp>
+#include <ellcpp/oracles/qmi_oracle.hpp>
+#include <ellcpp/oracles/sparse_lmi0_oracle.hpp>
+#include <ellcpp/oracles/sparse_lmi_oracle.hpp>
+#include <ellcpp/oracles/stacked_matrices.hpp>
 // #include <fmt/format.h>
 #include <gsl/span>
+#include <optional>
 // #include <spdlog/sinks/stdout_sinks.h>
 // #include <spdlog/spdlog.h>
+#include <stdexcept>
 #include <vector>
 #include <xtensor-blas/xlinalg.hpp>
+#include <xtensor/xmanipulation.hpp>
+#include <xtensor/xrandom.hpp>
 
 /*!
  * @brief my_oracle
@@ -29,6 +48,8 @@ class my_oracle
     const Arr c;
 
   public:
+    static constexpr bool linear_objective = true; //!< cut: c' x - t \le 0
+
     /*!
      * @brief Construct a new my oracle object
      *
@@ -51,7 +72,7 @@ class my_oracle
      *
      * @param[in] x
      * @param[in] t
-     * @return std::tuple<Cut, double>
+     * @return std::tuple<Cut, bool>
      */
     std::tuple<Cut, bool> operator()(const Arr& x, double& t)
     {
@@ -76,6 +97,124 @@ class my_oracle
     }
 };
 
+using Arr = xt::xarray<double, xt::layout_type::row_major>;
+using M_t = std::vector<Arr>;
+using Cut = std::tuple<Arr, double>;
+
+// min c' x  s.t.  B1 - F1 x >= 0, B2 - F2 x >= 0; optimum -3.1535
+static const auto c = Arr {1., -1., 1.};
+static const auto F1 = M_t {{{-7., -11.}, {-11., 3.}},
+    {{7., -18.}, {-18., 8.}}, {{-2., -8.}, {-8., 1.}}};
+static const auto B1 = Arr {{33., -9.}, {-9., 26.}};
+static const auto F2 = M_t {{{-21., -11., 0.}, {-11., 10., 8.}, {0., 8., 5.}},
+    {{0., 10., 16.}, {10., -10., -10.}, {16., -10., 3.}},
+    {{-5., 2., -17.}, {2., -6., 8.}, {-17., 8., 6.}}};
+static const auto B2 = Arr {{14., 9., 40.}, {9., 91., 10.}, {40., 10., 15.}};
+
+/*!
+ * @brief The nonzeros of the F_k, each from either triangle
+ *
+ * @param[in] F
+ * @return std::vector<coo_matrix>
+ */
+static auto to_coo(const M_t& F) -> std::vector<coo_matrix>
+{
+    auto res = std::vector<coo_matrix> {};
+    for (const auto& Fk : F)
+    {
+        auto& A = res.emplace_back();
+        for (auto i = 0U; i != Fk.shape()[0]; ++i)
+        {
+            for (auto j = 0U; j <= i; ++j)
+            {
+                if (Fk(i, j) != 0.)
+                {
+                    A.row.push_back(i % 2 == 0 ? i : j);
+                    A.col.push_back(i % 2 == 0 ? j : i);
+                    A.val.push_back(Fk(i, j));
+                }
+            }
+        }
+    }
+    return res;
+}
+
+/*!
+ * @brief Check that two feasibility oracles agree at a point
+ *
+ * @param[in] cut0
+ * @param[in] cut1
+ * @return true if x is cut off
+ */
+static auto same_cut(
+    const std::optional<Cut>& cut0, const std::optional<Cut>& cut1) -> bool
+{
+    REQUIRE(bool(cut0) == bool(cut1));
+    if (!cut0)
+    {
+        return false;
+    }
+    const auto& [g0, ep0] = *cut0;
+    const auto& [g1, ep1] = *cut1;
+    CHECK(ep1 == doctest::Approx(ep0));
+    for (auto k = 0U; k != g0.size(); ++k)
+    {
+        CHECK(g1(k) == doctest::Approx(g0(k)));
+    }
+    return true;
+}
+
+/*!
+ * @brief Check that two feasibility oracles agree at the rows of X
+ *
+ * @param[in,out] P0
+ * @param[in,out] P1
+ * @param[in] X one point per row
+ * @return int number of points cut off
+ */
+template <typename Oracle0, typename Oracle1>
+static auto same_cuts(Oracle0& P0, Oracle1& P1, const Arr& X) -> int
+{
+    auto num_cuts = 0;
+    for (auto p = 0U; p != X.shape()[0]; ++p)
+    {
+        const auto x = Arr {xt::view(X, p, xt::all())};
+        num_cuts += int(same_cut(P0(x), P1(x)));
+    }
+    return num_cuts;
+}
+
+/*!
+ * @brief min c' x subject to the LMIs, by cutting_plane_dc() from an ell
+ *        of radius 10 about the origin
+ *
+ * @param[in,out] P feasibility oracles, asked in turn
+ * @return std::tuple<double, Arr> the optimal value and solution
+ */
+template <typename... Oracles>
+static auto solve_lmis(Oracles&... P) -> std::tuple<double, Arr>
+{
+    auto omega = [&](const Arr& x, double& t) -> std::tuple<Cut, bool> {
+        auto cut = std::optional<Cut> {};
+        if ((bool(cut = P(x)) || ...))
+        {
+            return {std::move(*cut), false};
+        }
+        const auto f0 = xt::linalg::dot(c, x)();
+        if (f0 - t > 0)
+        {
+            return {{c, f0 - t}, false};
+        }
+        t = f0;
+        return {{c, 0.}, true};
+    };
+    auto E = ell(10., Arr {0., 0., 0.});
+    auto t = 1.e100;
+    auto [x, info] = cutting_plane_dc(omega, E, t);
+    CHECK(info.feasible);
+    return {t, std::move(x)};
+}
+
 TEST_CASE("LMI test (stable)")
 {
     using Arr = xt::xarray<double, xt::layout_type::row_major>;
@@ -135,3 +274,576 @@ TEST_CASE("LMI test ")
     CHECK(ell_info.feasible);
     CHECK(ell_info.num_iters == 112);
 }
+
+TEST_CASE("LMI test (cut pool)")
+{
+    auto P0 = my_oracle(F1, B1, F2, B2, c);
+    auto E0 = ell(10., Arr {0., 0., 0.});
+    auto t0 = 1.e100;
+    cutting_plane_dc(P0, E0, t0);
+
+    auto P = cut_pool {my_oracle(F1, B1, F2, B2, c)};
+    auto E = ell(10., Arr {0., 0., 0.});
+    auto t = 1.e100;
+    const auto [x, ell_info] = cutting_plane_dc(P, E, t);
+
+    CHECK(ell_info.feasible);
+    CHECK(t == doctest::Approx(t0).epsilon(1e-4));
+    CHECK(P.hits() > 0);
+    CHECK(P.calls() + P.hits() == ell_info.num_iters);
+}
+
+TEST_CASE("cut pool (parallel cuts)")
+{
+    using PCut = std::tuple<Arr, Arr>;
+
+    // |x_0| <= 1, as the parallel cut (e_0, {x_0 - 1, x_0 + 1})
+    auto slab = [](const Arr& x) -> std::optional<PCut> {
+        if (std::abs(x(0)) <= 1.)
+        {
+            return {};
+        }
+        return PCut {Arr {1., 0.}, Arr {x(0) - 1., x(0) + 1.}};
+    };
+    auto P = cut_pool {slab};
+    REQUIRE(P(Arr {2., 0.}));
+    CHECK(P.calls() == 1U);
+
+    // beyond the other side of the stored slab: screened, flipped
+    const auto cut = P(Arr {-3., 5.});
+    REQUIRE(cut);
+    CHECK(P.calls() == 1U);
+    CHECK(P.hits() == 1U);
+    const auto& [g, beta] = *cut;
+    CHECK(g(0) == -1.);
+    CHECK(g(1) == 0.);
+    CHECK(beta(0) == doctest::Approx(2.));
+    CHECK(beta(1) == doctest::Approx(4.));
+
+    // inside the slab: the oracle is asked
+    CHECK(!P(Arr {0.5, 0.}));
+    CHECK(P.calls() == 2U);
+}
+
+TEST_CASE("LMI test (accpm)")
+{
+    auto P = my_oracle(F1, B1, F2, B2, c);
+    auto S = accpm(10., Arr {0., 0., 0.});
+
+    auto t = 1.e100; // std::numeric_limits<double>::max()
+    const auto [x, ell_info] = cutting_plane_dc(P, S, t);
+
+    CHECK(ell_info.feasible);
+    CHECK(t == doctest::Approx(-3.1535).epsilon(1e-4));
+    CHECK(ell_info.num_iters < 113); // far fewer oracle calls than ell
+}
+
+TEST_CASE("LMI test (accpm, Newton failure)")
+{
+    auto S = accpm(10., Arr {0., 0., 0.});
+    S.newton_max_it = 0; // the new center can never be reached
+    const auto [status, tsq] = S.update(std::tuple {Arr {1., 0., 0.}, 0.});
+    CHECK(status == CUTStatus::noeffect); // not reported as infeasible
+    CHECK(tsq > 0.);
+    CHECK(S.xc()(0) == 0.);
+}
+
+TEST_CASE("LMI test (parallel probing)")
+{
+    auto Ps = std::vector<my_oracle> {};
+    for (auto i = 0; i != 5; ++i)
+    {
+        Ps.emplace_back(F1, B1, F2, B2, c);
+    }
+    auto E = ell(10., Arr {0., 0., 0.});
+
+    auto t = 1.e100; // std::numeric_limits<double>::max()
+    const auto [x, ell_info] = cutting_plane_probe(Ps, E, t);
+
+    CHECK(ell_info.feasible);
+    CHECK(t == doctest::Approx(-3.1535).epsilon(1e-4));
+    CHECK(ell_info.num_iters < 113); // fewer rounds than cutting_plane_dc
+
+    auto none = std::vector<my_oracle> {};
+    CHECK_THROWS_AS(cutting_plane_probe(none, E, t), std::invalid_argument);
+}
+
+TEST_CASE("ell probe points")
+{
+    // Q = diag(4, 1, 9): extents 2, 1, 3, taken longest first
+    const auto xc = Arr {1., 2., 3.};
+    const auto E = ell(Arr {4., 1., 9.}, xc);
+    const auto points = E.probe_points(5, 0.5);
+    REQUIRE(points.size() == 5U);
+    const auto expected = std::array<Arr, 5> {Arr {1., 2., 4.5},
+        Arr {1., 2., 1.5}, Arr {2., 2., 3.}, Arr {0., 2., 3.},
+        Arr {1., 2.5, 3.}};
+    for (auto j = 0U; j != 5U; ++j)
+    {
+        for (auto i = 0U; i != 3U; ++i)
+        {
+            CHECK(points[j](i) == doctest::Approx(expected[j](i)));
+        }
+    }
+    CHECK(E.probe_points(10, 0.5).size() == 6U); // at most 2 n
+}
+
+TEST_CASE("LMI test (gap termination)")
+{
+    auto P = my_oracle(F1, B1, F2, B2, c);
+    auto E = ell(10., Arr {0., 0., 0.});
+    auto options = Options();
+    options.gap_tol = 1e-3;
+
+    auto t = 1.e100; // std::numeric_limits<double>::max()
+    const auto [x, ell_info] = cutting_plane_dc(P, E, t, options);
+
+    CHECK(ell_info.feasible);
+    CHECK(ell_info.gap <= 1e-3);
+    CHECK(t - 1e-3 <= -3.1535);
+    CHECK(ell_info.num_iters < 113);
+}
+
+TEST_CASE("LMI test (composite oracle)")
+{
+    auto lmi1 = lmi_oracle {F1, B1};
+    auto lmi2 = lmi_oracle {F2, B2};
+    const auto t0 = std::get<0>(solve_lmis(lmi1, lmi2));
+
+    auto solve = [&](bool deterministic) {
+        auto lmis = composite_oracle {lmi_oracle(F1, B1), lmi_oracle(F2, B2)};
+        lmis.deterministic = deterministic;
+        const auto t = std::get<0>(solve_lmis(lmis));
+        const auto& s0 = lmis.statistics(0);
+        const auto& s1 = lmis.statistics(1);
+        CHECK(s0.violations + s1.violations > 0);
+        CHECK(s0.violations <= s0.calls);
+        CHECK(s1.violations <= s1.calls);
+        return std::make_tuple(t, lmis.order());
+    };
+
+    const auto [t1, order1] = solve(true);
+    const auto [t2, order2] = solve(true);
+    CHECK(t1 == t2); // reproducible
+    CHECK(order1 == order2);
+    CHECK(t1 == doctest::Approx(t0).epsilon(1e-4));
+
+    const auto [t3, order3] = solve(false);
+    CHECK(t3 == doctest::Approx(t0).epsilon(1e-4));
+}
+
+TEST_CASE("composite oracle (reordering)")
+{
+    using Res = std::optional<double>;
+
+    // sub-oracle 0 never cuts, sub-oracle 1 always does
+    auto never = [](double /*x*/) -> Res { return {}; };
+    auto always = [](double x) -> Res { return x; };
+
+    // by frequency of violation
+    auto Q1 = composite_oracle {never, always};
+    Q1.deterministic = true;
+    Q1.reorder_period = 4;
+    CHECK(Q1.order() == std::array<size_t, 2> {0U, 1U});
+    for (auto i = 0; i != 8; ++i)
+    {
+        CHECK(Q1(1.) == Res {1.});
+    }
+    CHECK(Q1.order() == std::array<size_t, 2> {1U, 0U});
+    CHECK(Q1.statistics(0).calls == 3); // skipped since the reordering
+    CHECK(Q1.statistics(1).violations == 8);
+
+    // by cost, for the same frequency
+    auto Q2 = composite_oracle {always, always};
+    Q2.deterministic = true;
+    Q2.reorder_period = 4;
+    Q2.weights = {10., 1.};
+    for (auto i = 0; i != 4; ++i)
+    {
+        Q2(1.);
+    }
+    CHECK(Q2.order() == std::array<size_t, 2> {1U, 0U});
+
+    // no reordering
+    auto Q3 = composite_oracle {never, always};
+    Q3.reorder_period = 0;
+    for (auto i = 0; i != 8; ++i)
+    {
+        Q3(1.);
+    }
+    CHECK(Q3.order() == std::array<size_t, 2> {0U, 1U});
+}
+
+TEST_CASE("LMI test (batch evaluation)")
+{
+    const auto X = Arr {{0., 0., 0.}, {1., -1., 1.}, {-2., 0.5, 3.},
+        {5., 5., 5.}};
+
+    // one result per point, equal to the point-by-point ones
+    auto check = [&](auto& Omega) {
+        const auto cuts = Omega.evaluate_batch(X);
+        REQUIRE(cuts.size() == X.shape()[0]);
+        for (auto p = 0U; p != X.shape()[0]; ++p)
+        {
+            const auto x = Arr {xt::view(X, p, xt::all())};
+            same_cut(Omega(x), cuts[p]);
+        }
+        return std::count_if(cuts.begin(), cuts.end(),
+            [](const auto& cut) { return bool(cut); });
+    };
+
+    auto lmi = lmi_oracle {F1, B1};
+    CHECK(check(lmi) > 0);
+    auto lmi0 = lmi0_oracle {F2};
+    CHECK(check(lmi0) > 0);
+    auto qmi = qmi_oracle {F1, B1};
+    qmi.update(2000.);
+    const auto num_cuts = check(qmi);
+    CHECK(num_cuts > 0);
+    CHECK(num_cuts < 4);
+}
+
+TEST_CASE("LMI test (gradient engine)")
+{
+    // large enough for the threaded path: n * |p|^2 / 2 > 2^20
+    constexpr auto m = 96U;
+    constexpr auto n = 256U;
+    auto F = std::vector<Arr> {};
+    for (auto k = 0U; k != n; ++k)
+    {
+        auto Fk = Arr {xt::random::rand<double>({m, m}) - 0.5};
+        F.emplace_back(Arr {Fk + xt::transpose(Fk)});
+    }
+    const auto Fc = detail::pack_lower(F);
+
+    // the witness spans rows [0, m - 1]
+    auto A = Arr {xt::eye(m)};
+    A(m - 1, m - 1) = -1.;
+    A(m - 1, 0) = A(0, m - 1) = 0.5;
+    auto Q = ldlt_ext {m};
+    REQUIRE(!Q.factorize(A));
+    Q.witness();
+    REQUIRE(Q.p.second == m);
+
+    auto g = Arr {xt::zeros<double>({n})};
+    detail::packed_sym_quad(Fc, Q.v, Q.p, -1., g);
+    for (auto k = 0U; k != n; ++k)
+    {
+        CHECK(g(k) == doctest::Approx(-Q.sym_quad(F[k])));
+    }
+}
+
+TEST_CASE("LMI test (sparse)")
+{
+    const auto X = Arr {{0., 0., 0.}, {1., -1., 1.}, {-2., 0.5, 3.},
+        {5., 5., 5.}};
+
+    // same cuts as the dense oracles
+    auto lmi = lmi_oracle {F1, B1};
+    auto sparse_lmi = sparse_lmi_oracle {to_coo(F1), B1};
+    CHECK(same_cuts(lmi, sparse_lmi, X) > 0);
+    auto lmi0 = lmi0_oracle {F2};
+    auto sparse_lmi0 = sparse_lmi0_oracle {3U, to_coo(F2)};
+    CHECK(same_cuts(lmi0, sparse_lmi0, X) > 0);
+}
+
+TEST_CASE("LMI test (low rank)")
+{
+    constexpr auto m = 6U;
+    auto entry = [](size_t i, size_t j, size_t seed) {
+        return double(int((3 * i + 5 * j + seed) % 7) - 3);
+    };
+
+    // F_0, F_1 dense; F_2 = u u', F_3 = (U V' + V U') / 2 of rank 2
+    auto F = M_t {};
+    for (auto seed : {1U, 4U})
+    {
+        auto& Fk = F.emplace_back(zeros({m, m}));
+        for (auto i = 0U; i != m; ++i)
+        {
+            for (auto j = 0U; j <= i; ++j)
+            {
+                Fk(i, j) = Fk(j, i) = entry(i, j, seed);
+            }
+        }
+    }
+    auto L = std::vector<low_rank_matrix> {};
+    L.push_back({zeros({m, 1U}), zeros({m, 1U})});
+    L.push_back({zeros({m, 2U}), zeros({m, 2U})});
+    for (auto i = 0U; i != m; ++i)
+    {
+        L[0].U(i, 0) = L[0].V(i, 0) = entry(i, 0, 2);
+        for (auto r = 0U; r != 2; ++r)
+        {
+            L[1].U(i, r) = entry(i, r, 3);
+            L[1].V(i, r) = entry(i, r, 6);
+        }
+    }
+    auto F_dense = F;
+    for (const auto& Lk : L)
+    {
+        auto& Fk = F_dense.emplace_back(zeros({m, m}));
+        for (auto i = 0U; i != m; ++i)
+        {
+            for (auto j = 0U; j != m; ++j)
+            {
+                for (auto r = 0U; r != Lk.U.shape()[1]; ++r)
+                {
+                    Fk(i, j) += (Lk.U(i, r) * Lk.V(j, r)
+                                    + Lk.V(i, r) * Lk.U(j, r)) / 2.;
+                }
+            }
+        }
+    }
+    auto B = Arr {10. * xt::eye(m)};
+    const auto X = Arr {{0., 0., 0., 0.}, {1., -1., 0.5, 0.2},
+        {-0.3, 0.4, 1., -1.}, {2., 2., 2., 2.}, {-3., 1., -2., 0.5}};
+
+    auto dense = lmi_oracle {F_dense, B};
+    auto mixed = lmi_oracle {F, L, B};
+    const auto batch = mixed.evaluate_batch(X);
+    auto num_cuts = 0;
+    for (auto p = 0U; p != X.shape()[0]; ++p)
+    {
+        const auto x = Arr {xt::view(X, p, xt::all())};
+        const auto cut0 = dense(x);
+        num_cuts += int(same_cut(cut0, mixed(x)));
+        same_cut(cut0, batch[p]);
+    }
+    CHECK(num_cuts > 0);
+    CHECK(num_cuts < int(X.shape()[0]));
+
+    // low-rank terms only
+    auto lr = lmi_oracle {gsl::span<const Arr> {}, L, B};
+    const auto F_lr = M_t(F_dense.begin() + 2, F_dense.end());
+    auto dense_lr = lmi_oracle {F_lr, B};
+    for (const auto& x : {Arr {0., 0.}, Arr {2., -1.}, Arr {-3., 3.}})
+    {
+        const auto cut0 = dense_lr(x);
+        const auto cut1 = lr(x);
+        REQUIRE(bool(cut0) == bool(cut1));
+        if (cut0)
+        {
+            CHECK(std::get<1>(*cut1) == doctest::Approx(std::get<1>(*cut0)));
+        }
+    }
+}
+
+TEST_CASE("LMI test (adaptive pivoting)")
+{
+    // A = diag(1, ..., 1, -1): fails at the last row, then at the first
+    constexpr auto m = 20U;
+    auto F = M_t {Arr {xt::eye(m)}, Arr {xt::zeros<double>({m, m})}};
+    F[1](m - 1, m - 1) = 1.;
+    const auto x = Arr {1., -2.};
+    auto P = lmi0_oracle {F};
+    P.set_adaptive_pivoting(true);
+    for (auto stop : {m, 1U, 1U})
+    {
+        const auto cut = P(x);
+        REQUIRE(cut);
+        CHECK(P._Q.p.second == stop);
+        const auto& [g, ep] = *cut;
+        CHECK(ep > 0.);
+        CHECK(ep == doctest::Approx(xt::linalg::dot(g, x)())); // -v' A v
+        CHECK(g(1) == doctest::Approx(-1.));
+    }
+
+    // same verdicts and an optimum as good as with the natural order
+    auto solve = [&](bool adaptive) {
+        auto lmi1 = lmi_oracle {F1, B1};
+        auto lmi2 = lmi_oracle {F2, B2};
+        auto lmi3 = lmi0_oracle {F2};
+        lmi1.set_adaptive_pivoting(adaptive);
+        lmi2.set_adaptive_pivoting(adaptive);
+        lmi3.set_adaptive_pivoting(adaptive);
+        auto num_lmi0_cuts = 0;
+        for (const auto& y : {Arr {1., 1., 1.}, Arr {-1., 2., 0.5},
+                 Arr {3., -1., 2.}, Arr {0.1, 0.1, -2.}})
+        {
+            const auto cut = lmi3(y);
+            if (cut)
+            {
+                ++num_lmi0_cuts;
+                const auto& [g, ep] = *cut;
+                CHECK(ep == doctest::Approx(xt::linalg::dot(g, y)()));
+            }
+        }
+        const auto t = std::get<0>(solve_lmis(lmi1, lmi2));
+        return std::make_tuple(t, num_lmi0_cuts);
+    };
+    const auto [t0, n0] = solve(false);
+    const auto [t1, n1] = solve(true);
+    CHECK(n0 > 0);
+    CHECK(n1 == n0);
+    CHECK(t1 == doctest::Approx(t0).epsilon(1e-3));
+}
+
+TEST_CASE("LMI test (mixed precision)")
+{
+    const auto X = Arr {{0., 0., 0.}, {1., -1., 1.}, {-2., 0.5, 3.},
+        {5., 5., 5.}, {-0.5, 0.2, 0.1}};
+
+    // same cuts as in double, up to float rounding
+    auto lmi = lmi_oracle {F1, B1};
+    auto lmi_mixed = lmi_oracle {F1, B1};
+    lmi_mixed.set_mixed_precision(true);
+    CHECK(same_cuts(lmi, lmi_mixed, X) > 0);
+    auto lmi0 = lmi0_oracle {F2};
+    auto lmi0_mixed = lmi0_oracle {F2};
+    lmi0_mixed.set_mixed_precision(true);
+    CHECK(same_cuts(lmi0, lmi0_mixed, X) > 0);
+}
+
+TEST_CASE("LMI test (Lanczos)")
+{
+    // B = tridiag(-1, 2, -1), F_0 = I: lambda_min = 2 - 2 cos(pi / 51) - x
+    constexpr auto m = 50U;
+    auto B = coo_matrix {};
+    auto I = coo_matrix {};
+    for (auto i = 0U; i != m; ++i)
+    {
+        B.row.push_back(i);
+        B.col.push_back(i);
+        B.val.push_back(2.);
+        I.row.push_back(i);
+        I.col.push_back(i);
+        I.val.push_back(1.);
+        if (i + 1 != m)
+        {
+            B.row.push_back(i + 1);
+            B.col.push_back(i);
+            B.val.push_back(-1.);
+        }
+    }
+    const auto lambda = 2. - 2. * std::cos(std::acos(-1.) / (m + 1));
+    auto P = lanczos_lmi_oracle {m, {I}, B};
+    for (auto x : {1., 0.5, lambda + 1e-3, 1.})
+    {
+        const auto cut = P(Arr {x});
+        REQUIRE(cut);
+        CHECK(P.min_eig() == doctest::Approx(lambda - x));
+        const auto& [g, ep] = *cut;
+        CHECK(g(0) == doctest::Approx(1.));     // |v| = 1
+        CHECK(ep == doctest::Approx(x - lambda)); // most violated
+    }
+    CHECK(!P(Arr {lambda - 1e-3}));
+    CHECK(!P(Arr {-1.}));
+
+    // same verdicts from the Ritz value alone
+    P.set_certification(false);
+    CHECK(!P(Arr {lambda - 1e-3}));
+    CHECK(P.min_eig() == doctest::Approx(1e-3));
+    CHECK(P(Arr {lambda + 1e-3}));
+    CHECK(!P(Arr {-1.}));
+
+    // same optimum as with the LDLT oracles
+    auto lmi1 = lmi_oracle {F1, B1};
+    auto lmi2 = lmi_oracle {F2, B2};
+    auto lanczos1 = lanczos_lmi_oracle {2U, to_coo(F1), to_coo({B1})[0]};
+    auto lanczos2 = lanczos_lmi_oracle {3U, to_coo(F2), to_coo({B2})[0]};
+    const auto [t0, z] = solve_lmis(lmi1, lmi2);
+    const auto t1 = std::get<0>(solve_lmis(lanczos1, lanczos2));
+    CHECK(t1 == doctest::Approx(t0).epsilon(1e-3));
+
+    // same verdicts as the LDLT oracle, and valid cuts
+    REQUIRE(!lmi2(z));
+    REQUIRE(!lanczos2(z));
+    for (const auto& y : {Arr {1., 1., 1.}, Arr {-1., 2., 0.5},
+             Arr {3., -1., 2.}, Arr {0.1, 0.1, -2.}, Arr {-0.5, 0.2, 0.1}})
+    {
+        const auto cut = lanczos2(y);
+        REQUIRE(bool(cut) == bool(lmi2(y)));
+        if (cut)
+        {
+            const auto& [g, ep] = *cut;
+            CHECK(ep > 0.);
+            CHECK(xt::linalg::dot(g, z - y)() + ep <= 0.);
+        }
+    }
+}
+
+TEST_CASE("LMI test (chordal, overlapping cliques)")
+{
+    // B - diag(x): B tridiagonal, a path graph (chordal, cliques {i, i+1})
+    constexpr auto m = 6U;
+    auto B = coo_matrix {};
+    auto F = std::vector<coo_matrix>(m);
+    auto Bd = Arr {xt::zeros<double>({m, m})};
+    auto Fd = std::vector<Arr>(m, Arr {xt::zeros<double>({m, m})});
+    for (auto i = 0U; i != m; ++i)
+    {
+        B.row.push_back(i);
+        B.col.push_back(i);
+        B.val.push_back(2.);
+        Bd(i, i) = 2.;
+        if (i + 1 != m)
+        {
+            B.row.push_back(i + 1);
+            B.col.push_back(i);
+            B.val.push_back(-1.);
+            Bd(i + 1, i) = Bd(i, i + 1) = -1.;
+        }
+        F[i] = coo_matrix {{i}, {i}, {1.}};
+        Fd[i](i, i) = 1.;
+    }
+
+    auto P = chordal_lmi_oracle {m, F, B};
+    CHECK(P.num_components() == 1U);
+    REQUIRE(P.cliques().size() == m - 1);
+    for (const auto& C : P.cliques())
+    {
+        CHECK(C.size() == 2U);
+    }
+
+    // a clique is violated; no clique is, but the whole matrix is; feasible
+    auto dense = lmi_oracle {Fd, Bd};
+    const auto y = Arr {xt::zeros<double>({m})}; // feasible
+    for (const auto& x : {Arr {3., 0., 0., 0., 0., 0.},
+             Arr {0.9, 0.9, 0.9, 0.9, 0.9, 0.9}, Arr {0.5, 0., 0., 0., 0., 0.}})
+    {
+        const auto cut = P(x);
+        REQUIRE(bool(cut) == bool(dense(x)));
+        if (cut)
+        {
+            const auto& [g, ep] = *cut;
+            CHECK(ep >= 0.);
+            CHECK(xt::linalg::dot(g, y - x)() + ep <= 1e-12);
+        }
+    }
+}
+
+TEST_CASE("LMI test (chordal, block diagonal)")
+{
+    // diag(B1, B2) - sum_k x_k diag(F1_k, F2_k), as one 5 x 5 LMI
+    auto add = [](coo_matrix& A, const Arr& M, size_t offset) {
+        for (auto i = 0U; i != M.shape()[0]; ++i)
+        {
+            for (auto j = 0U; j <= i; ++j)
+            {
+                A.row.push_back(offset + i);
+                A.col.push_back(offset + j);
+                A.val.push_back(M(i, j));
+            }
+        }
+    };
+    auto B = coo_matrix {};
+    add(B, B1, 0U);
+    add(B, B2, 2U);
+    auto F = std::vector<coo_matrix>(3);
+    for (auto k = 0U; k != 3U; ++k)
+    {
+        add(F[k], F1[k], 0U);
+        add(F[k], F2[k], 2U);
+    }
+
+    auto lmi = chordal_lmi_oracle {5U, F, B};
+    CHECK(lmi.num_components() == 2U);
+    const auto t = std::get<0>(solve_lmis(lmi));
+
+    // same optimum as with the two dense LMIs
+    auto lmi1 = lmi_oracle {F1, B1};
+    auto lmi2 = lmi_oracle {F2, B2};
+    const auto t0 = std::get<0>(solve_lmis(lmi1, lmi2));
+    CHECK(t == doctest::Approx(t0).epsilon(1e-4));
+}
@@ -10,6 +10,7 @@
 #include <ellcpp/oracles/lowpass_oracle.hpp>
 #include <ellcpp/utility.hpp>
 #include <limits>
+#include <vector>
 #include <xtensor-blas/xlinalg.hpp>
 #include <xtensor/xview.hpp>
 
@@ -99,7 +100,7 @@ static const auto Spsq = Sp * Sp;
 // optimization
 // ********************************************************************
 
-auto run_lowpass(bool use_parallel_cut)
+auto run_lowpass(bool use_parallel_cut, double cut_depth = 0.)
 {
     auto r0 = zeros({N}); // initial x0
     auto E = ell(40., r0);
@@ -107,6 +108,7 @@ auto run_lowpass(bool use_parallel_cut)
     auto options = Options();
 
     options.max_it = 50000;
+    options.cut_depth = cut_depth; // lazy oracle: pull the deepest cut
     E.use_parallel_cut = use_parallel_cut;
     // options.tol = 1e-8;
 
@@ -132,3 +134,45 @@ TEST_CASE("Lowpass Filter (w/o parallel cut)")
     CHECK(feasible);
     CHECK(num_iters >= 7479);
 }
+
+TEST_CASE("Lowpass Filter (w/ parallel cut, deepest lazy cut)")
+{
+    const auto [feasible, num_iters] = run_lowpass(true, 1.e100);
+    CHECK(feasible);
+    CHECK(num_iters <= 560);
+}
+
+TEST_CASE("Lowpass oracle (round robin across calls)")
+{
+    // every passband row is violated at x: row k gives the cut g(0) = k + 1
+    const auto Ap3 = Arr {{1., 0.}, {2., 0.}, {3., 0.}};
+    const auto As1 = Arr {{0., 0.}};
+    const auto Anr1 = Arr {{1., 0.}};
+    const auto x = Arr {1., 0.};
+    auto S = 1.;
+    auto P = lowpass_oracle(Ap3, As1, Anr1, 0.25, 0.5);
+
+    auto next_row = [&]() {
+        const auto [cut, shrunk] = P(x, S);
+        CHECK(!shrunk);
+        return std::get<0>(cut)(0);
+    };
+    auto lazy_rows = [&](size_t num_pulls) {
+        auto rows = std::vector<double> {};
+        auto cuts = P.generate(x, S);
+        for (; cuts && rows.size() != num_pulls; cuts())
+        {
+            rows.push_back(std::get<0>(std::get<0>(cuts.get()))(0));
+        }
+        return rows;
+    };
+
+    CHECK(next_row() == 1.);
+    // the lazy scan starts where the last taken cut left off, and does
+    // not move the position, however many cuts are pulled
+    CHECK(lazy_rows(1) == std::vector<double> {2.});
+    CHECK(lazy_rows(3) == std::vector<double> {2., 3., 1.});
+    CHECK(next_row() == 2.);
+    CHECK(next_row() == 3.);
+    CHECK(next_row() == 1.);
+}
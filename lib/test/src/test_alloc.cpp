@@ -0,0 +1,366 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <doctest/doctest.h>
+#include <ellcpp/cutting_plane.hpp>
+#include <ellcpp/ell.hpp>
+#include <ellcpp/ell_stable.hpp>
+#include <ellcpp/oracles/lmi_oracle.hpp>
+#include <ellcpp/oracles/optscaling_oracle.hpp>
+#include <ellcpp/oracles/profit_oracle.hpp>
+#include <ellcpp/point_memo.hpp>
+#include <new>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <xtensor/xarray.hpp>
+
+// Count the allocations of the whole test executable, but only while
+// counting is on (see num_allocs()). All the replaceable forms of
+// operator new and delete are replaced, so that none of them bypasses
+// the count, and every delete pairs with malloc.
+static std::atomic<size_t> g_num_allocs {0};
+static std::atomic<bool> g_counting {false};
+
+static auto counted_alloc(std::size_t size) noexcept -> void*
+{
+    if (g_counting)
+    {
+        ++g_num_allocs;
+    }
+    return std::malloc(size != 0 ? size : 1);
+}
+
+static auto counted_alloc(std::size_t size, std::align_val_t al) noexcept
+    -> void*
+{
+    if (g_counting)
+    {
+        ++g_num_allocs;
+    }
+    const auto a = static_cast<std::size_t>(al);
+    const auto rounded = size == 0 ? a : (size + a - 1) / a * a;
+    return std::aligned_alloc(a, rounded);
+}
+
+static auto checked(void* p) -> void*
+{
+    if (p == nullptr)
+    {
+        throw std::bad_alloc {};
+    }
+    return p;
+}
+
+void* operator new(std::size_t size)
+{
+    return checked(counted_alloc(size));
+}
+
+void* operator new[](std::size_t size)
+{
+    return checked(counted_alloc(size));
+}
+
+void* operator new(
+    std::size_t size, const std::nothrow_t& /* unused */) noexcept
+{
+    return counted_alloc(size);
+}
+
+void* operator new[](
+    std::size_t size, const std::nothrow_t& /* unused */) noexcept
+{
+    return counted_alloc(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t al)
+{
+    return checked(counted_alloc(size, al));
+}
+
+void* operator new[](std::size_t size, std::align_val_t al)
+{
+    return checked(counted_alloc(size, al));
+}
+
+void* operator new(std::size_t size, std::align_val_t al,
+    const std::nothrow_t& /* unused */) noexcept
+{
+    return counted_alloc(size, al);
+}
+
+void* operator new[](std::size_t size, std::align_val_t al,
+    const std::nothrow_t& /* unused */) noexcept
+{
+    return counted_alloc(size, al);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete(void* p, std::size_t /* unused */) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t /* unused */) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete(void* p, const std::nothrow_t& /* unused */) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t& /* unused */) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete(void* p, std::align_val_t /* unused */) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete[](void* p, std::align_val_t /* unused */) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete(void* p, std::size_t /* unused */,
+    std::align_val_t /* unused */) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t /* unused */,
+    std::align_val_t /* unused */) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete(void* p, std::align_val_t /* unused */,
+    const std::nothrow_t& /* unused */) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete[](void* p, std::align_val_t /* unused */,
+    const std::nothrow_t& /* unused */) noexcept
+{
+    ::operator delete(p);
+}
+
+using Arr = xt::xarray<double, xt::layout_type::row_major>;
+
+/*!
+ * @brief Number of allocations made by f()
+ *
+ * @tparam Fn
+ * @param[in] f
+ * @return size_t
+ */
+template <typename Fn>
+static auto num_allocs(Fn&& f) -> size_t
+{
+    g_num_allocs = 0;
+    g_counting = true;
+    f();
+    g_counting = false;
+    return g_num_allocs;
+}
+
+/*!
+ * @brief Options running exactly max_it iterations
+ *
+ * @param[in] max_it
+ * @return Options
+ */
+static auto run_for(unsigned int max_it) -> Options
+{
+    auto options = Options();
+    options.max_it = max_it;
+    options.tol = 0.;
+    return options;
+}
+
+/*!
+ * @brief Directed cycle 0 -> 1 -> ... -> n - 1 -> 0, edge i leaving node i
+ */
+class ring_graph
+{
+  public:
+    using node_t = size_t;
+    using edge_t = size_t;
+
+  private:
+    std::vector<size_t> _nodes;
+
+  public:
+    explicit ring_graph(size_t n)
+        : _nodes(n)
+    {
+        std::iota(this->_nodes.begin(), this->_nodes.end(), 0U);
+    }
+
+    auto begin() const
+    {
+        return this->_nodes.begin();
+    }
+
+    auto end() const
+    {
+        return this->_nodes.end();
+    }
+
+    auto edges() const -> const std::vector<size_t>&
+    {
+        return this->_nodes;
+    }
+
+    auto end_points(size_t e) const -> std::pair<size_t, size_t>
+    {
+        return {e, (e + 1) % this->_nodes.size()};
+    }
+
+    static auto null_vertex() -> size_t
+    {
+        return size_t(-1);
+    }
+};
+
+// A run of twice the iterations must not allocate more: the cut buffer,
+// the ellipsoid and the oracles only allocate in the first iteration.
+
+TEST_CASE("No allocation in steady state: cutting_plane_dc")
+{
+    auto solve = [](unsigned int max_it, auto E) {
+        auto P =
+            profit_oracle {20., 40., 30.5, Arr {0.1, 0.4}, Arr {10., 35.}};
+        auto num_iters = size_t {0};
+        const auto count = num_allocs([&] {
+            const auto [y, info] =
+                cutting_plane_dc(P, E, 0., run_for(max_it));
+            num_iters = info.num_iters;
+        });
+        CHECK(num_iters == size_t(max_it));
+        return count;
+    };
+
+    CHECK(solve(10, ell {100., Arr {0., 0.}})
+        == solve(20, ell {100., Arr {0., 0.}}));
+    CHECK(solve(10, ell_stable {100., Arr {0., 0.}})
+        == solve(20, ell_stable {100., Arr {0., 0.}}));
+}
+
+TEST_CASE("No allocation in steady state: cutting_plane_feas")
+{
+    // |x_k - a_k| <= 1e-6: a box too small to be hit within max_it
+    const auto a = Arr {3., -2., 1.};
+    auto F = std::vector<Arr>(3, Arr {xt::zeros<double>({6, 6})});
+    auto B = Arr {xt::zeros<double>({6, 6})};
+    for (auto k = 0U; k != 3U; ++k)
+    {
+        F[k](2 * k, 2 * k) = 1.;
+        F[k](2 * k + 1, 2 * k + 1) = -1.;
+        B(2 * k, 2 * k) = 1e-6 + a(k);
+        B(2 * k + 1, 2 * k + 1) = 1e-6 - a(k);
+    }
+
+    auto solve = [&](unsigned int max_it) {
+        auto P = lmi_oracle {F, B};
+        auto E = ell {10., Arr {0., 0., 0.}};
+        auto num_iters = size_t {0};
+        const auto count = num_allocs([&] {
+            const auto info = cutting_plane_feas(P, E, run_for(max_it));
+            num_iters = info.num_iters;
+        });
+        CHECK(num_iters == size_t(max_it));
+        return count;
+    };
+
+    CHECK(solve(4) == solve(10));
+}
+
+TEST_CASE("No allocation in steady state: cutting_plane_q")
+{
+    auto solve = [](unsigned int max_it) {
+        auto P =
+            profit_q_oracle {20., 40., 30.5, Arr {0.1, 0.4}, Arr {10., 35.}};
+        auto E = ell {100., Arr {0., 0.}};
+        auto num_iters = size_t {0};
+        const auto count = num_allocs([&] {
+            const auto [y, info] =
+                cutting_plane_q(P, E, 0., run_for(max_it));
+            num_iters = info.num_iters;
+        });
+        CHECK(num_iters == size_t(max_it));
+        return count;
+    };
+
+    CHECK(solve(10) == solve(20));
+}
+
+TEST_CASE("No allocation in steady state: network oracle")
+{
+    // optimal scaling of the cyclic matrix of test_optscaling_boost.cpp
+    const auto G = ring_graph {5};
+    const auto elem = std::vector<double> {1.2, 2.3, 3.4, -4.5, 5.6};
+    auto get_cost = [&elem](size_t e) -> double
+    { return std::log(std::abs(elem[e])); };
+
+    auto solve = [&](unsigned int max_it) {
+        auto dist = std::vector<double>(5, 0.);
+        auto P = optscaling_oracle<ring_graph, std::vector<double>,
+            decltype(get_cost)> {G, dist, get_cost};
+        const auto cmax = std::log(5.6);
+        const auto cmin = std::log(1.2);
+        auto E = ell {1.5 * (cmax - cmin), Arr {cmax, cmin}};
+        auto num_iters = size_t {0};
+        const auto count = num_allocs([&] {
+            const auto [x, info] =
+                cutting_plane_dc(P, E, 1.e100, run_for(max_it));
+            num_iters = info.num_iters;
+        });
+        CHECK(num_iters == size_t(max_it));
+        return count;
+    };
+
+    CHECK(solve(10) == solve(20));
+}
+
+TEST_CASE("No allocation in steady state: point_memo hits")
+{
+    using Cut = std::tuple<Arr, double>;
+
+    // re-targeting a stored cut costs no allocation; only storing does
+    auto rounds = [](unsigned int n) {
+        auto E = ell {100., Arr {0., 0.}};
+        auto memo = detail::point_memo<Arr, Cut, double> {};
+        const auto xd = Arr {1., 1.};
+        memo.store(xd, Cut {Arr {1., 0.}, 0.}, E.xc_ref(), 0.);
+        return num_allocs([&] {
+            for (auto i = 0U; i != n; ++i)
+            {
+                auto* cut = memo.find(xd, 0.);
+                REQUIRE(cut != nullptr);
+                memo.update(E, *cut, xd, E.xc_ref());
+            }
+        });
+    };
+
+    CHECK(rounds(10) == rounds(20));
+}
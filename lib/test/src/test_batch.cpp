@@ -0,0 +1,54 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include <doctest/doctest.h>
+#include <ellcpp/batch_solve.hpp>
+#include <ellcpp/ell.hpp>
+#include <ellcpp/oracles/profit_oracle.hpp>
+#include <tuple>
+#include <vector>
+#include <xtensor/xarray.hpp>
+
+TEST_CASE("Batch solve (profit scenarios)")
+{
+    using Vec = xt::xarray<double, xt::layout_type::row_major>;
+    using Job = std::tuple<profit_oracle, ell, double>;
+
+    const auto p = 20.;
+    const auto A = 40.;
+    const auto a = Vec {0.1, 0.4};
+    const auto v = Vec {10., 35.};
+
+    auto make_jobs = [&]() {
+        auto jobs = std::vector<Job> {};
+        for (auto i = 0; i != 32; ++i)
+        {
+            const auto k = 20. + 0.5 * i;
+            jobs.emplace_back(profit_oracle {p, A, k, a, v},
+                ell {100., Vec {0., 0.}}, 0.);
+        }
+        return jobs;
+    };
+
+    auto jobs = make_jobs();
+    auto seq = make_jobs();
+
+    auto count = std::vector<int>(jobs.size(), 0);
+    auto num_iters = std::vector<size_t>(jobs.size(), 0);
+    cutting_plane_dc_batch(
+        jobs,
+        [&](size_t i, const Vec& /*y*/, double /*t*/, const CInfo& info) {
+            ++count[i];
+            num_iters[i] = info.num_iters;
+        },
+        4);
+
+    for (auto i = 0U; i != seq.size(); ++i)
+    {
+        auto& [P, E, t] = seq[i];
+        const auto [y, ell_info] = cutting_plane_dc(P, E, t);
+        CHECK(count[i] == 1);
+        CHECK(num_iters[i] == ell_info.num_iters);
+        CHECK(std::get<2>(jobs[i]) == doctest::Approx(t));
+    }
+}
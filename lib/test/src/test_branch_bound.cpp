@@ -0,0 +1,92 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include <cmath>
+#include <doctest/doctest.h>
+#include <ellcpp/branch_bound.hpp>
+#include <ellcpp/ell.hpp>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include <xtensor/xarray.hpp>
+
+using Vec = xt::xarray<double, xt::layout_type::row_major>;
+
+/*!
+ * @brief f(x) = (x - c)' Q (x - c), with strongly coupled variables
+ */
+class quad_oracle
+{
+    using Cut = std::tuple<Vec, double>;
+
+  public:
+    static auto f(double x0, double x1) -> double
+    {
+        const auto d0 = x0 - 0.4;
+        const auto d1 = x1 - 2.6;
+        return 2. * d0 * d0 + 3. * d0 * d1 + 2. * d1 * d1;
+    }
+
+    auto operator()(const Vec& x, double& t) const -> std::tuple<Cut, bool>
+    {
+        const auto d0 = x[0] - 0.4;
+        const auto d1 = x[1] - 2.6;
+        const auto fx = f(x[0], x[1]);
+        auto g = Vec {4. * d0 + 3. * d1, 3. * d0 + 4. * d1};
+        if (fx < t)
+        {
+            t = fx;
+            return {{std::move(g), 0.}, true};
+        }
+        return {{std::move(g), fx - t}, false};
+    }
+};
+
+TEST_CASE("Branch and bound (all integer)")
+{
+    auto t_star = std::numeric_limits<double>::infinity();
+    for (auto i = -10; i <= 10; ++i)
+    {
+        for (auto j = -10; j <= 10; ++j)
+        {
+            t_star = std::min(t_star, quad_oracle::f(i, j));
+        }
+    }
+
+    const auto E = ell {100., Vec {0., 0.}};
+    auto t = std::numeric_limits<double>::infinity();
+    const auto [x, info] = branch_bound([] { return quad_oracle {}; }, E,
+        std::vector<bool> {true, true}, t, 4);
+    CHECK(info.feasible);
+    CHECK(info.status == CUTStatus::success);
+    CHECK(x[0] == std::round(x[0]));
+    CHECK(x[1] == std::round(x[1]));
+    CHECK(t == doctest::Approx(t_star));
+}
+
+TEST_CASE("Branch and bound (mixed integer)")
+{
+    // x0 integer: x1 = 2.6 - 0.75 (x0 - 0.4), f = 0.875 (x0 - 0.4)^2
+    const auto E = ell {100., Vec {0., 0.}};
+    auto t = std::numeric_limits<double>::infinity();
+    const auto [x, info] = branch_bound([] { return quad_oracle {}; }, E,
+        std::vector<bool> {true, false}, t, 4);
+    CHECK(info.feasible);
+    CHECK(x[0] == 0.);
+    CHECK(t == doctest::Approx(0.875 * 0.16).epsilon(1e-4));
+}
+
+TEST_CASE("Branch and bound (integer mask of the wrong size)")
+{
+    const auto E = ell {100., Vec {0., 0.}};
+    auto t = std::numeric_limits<double>::infinity();
+    auto make_oracle = [] { return quad_oracle {}; };
+    const auto too_short = std::vector<bool> {true};
+    const auto too_long = std::vector<bool> {true, false, true};
+    CHECK_THROWS_AS(branch_bound(make_oracle, E, too_short, t, 1),
+        std::invalid_argument);
+    CHECK_THROWS_AS(
+        branch_bound(make_oracle, E, too_long, t, 1), std::invalid_argument);
+    CHECK(t == std::numeric_limits<double>::infinity());
+}
@@ -0,0 +1,98 @@
+/*
+ *  Distributed under the MIT License (See accompanying file /LICENSE )
+ */
+#include <doctest/doctest.h>
+#include <ellcpp/cutting_plane.hpp>
+#include <py2cpp/fractions.hpp>
+#include <tuple>
+#include <utility>
+
+TEST_CASE("bsearch (galloping, double)")
+{
+    auto num_calls = 0U;
+    auto Omega = [&](double t) {
+        ++num_calls;
+        return t >= 3.14159;
+    };
+
+    const auto [I, info] = bsearch_gallop(Omega, 1000., 1.);
+    CHECK(info.feasible);
+    CHECK(I.first < 3.14159);
+    CHECK(I.second >= 3.14159);
+    CHECK(I.second - I.first < 2e-8);
+    CHECK(info.num_iters == num_calls + 1); // bsearch counts one extra
+
+    num_calls = 0U;
+    const auto [I2, info2] =
+        bsearch_gallop(Omega, 0., 1., Options {2000, 1e-8});
+    CHECK(info2.feasible);
+    CHECK(I2.second - I2.first < 2e-8);
+    CHECK(I2.second >= 3.14159);
+}
+
+TEST_CASE("bsearch (galloping, int)")
+{
+    auto Omega = [](int t) { return t >= 37; };
+
+    const auto [I, info] = bsearch_gallop(Omega, 0, 1, Options {2000, 1});
+    CHECK(info.feasible);
+    CHECK(I.second == 37);
+
+    const auto [I2, info2] = bsearch_gallop(Omega, 1000, 3, Options {2000, 1});
+    CHECK(info2.feasible);
+    CHECK(I2.second == 37);
+}
+
+TEST_CASE("bsearch (galloping, Fraction)")
+{
+    using Q = fun::Fraction<int>;
+    auto Omega = [](const Q& t) { return t >= Q(9, 5); };
+
+    // the tolerance is a Fraction too: the search stops on the width
+    const auto [I, info] =
+        bsearch_gallop(Omega, Q(5), Q(1), Options(), Q(1, 100));
+    CHECK(info.feasible);
+    CHECK(info.status == CUTStatus::smallenough);
+    CHECK(I.first < Q(9, 5));
+    CHECK(I.second >= Q(9, 5));
+    CHECK(I.second - I.first < Q(1, 50));
+}
+
+TEST_CASE("bsearch (galloping, infeasible)")
+{
+    auto Omega = [](double) { return false; };
+
+    const auto [I, info] = bsearch_gallop(Omega, 0., 1., Options {20, 1e-8});
+    CHECK(!info.feasible);
+    CHECK(info.status == CUTStatus::nosoln);
+}
+
+TEST_CASE("bsearch (slack-aware)")
+{
+    // s(t) = t^2 - t*^2: feasible iff t >= t*
+    const auto t_star = 3.14159;
+    auto num_calls = 0U;
+    auto Omega = [&](double t) {
+        ++num_calls;
+        const auto s = t * t - t_star * t_star;
+        return std::make_tuple(s >= 0., s);
+    };
+    auto Omega_bool = [&](double t) {
+        ++num_calls;
+        return t >= t_star;
+    };
+
+    auto I = std::make_pair(0., 100.);
+    const auto info = bsearch_slack(Omega, I);
+    CHECK(info.feasible);
+    CHECK(I.first < t_star);
+    CHECK(I.second >= t_star);
+    CHECK(I.second - I.first < 2e-8);
+    const auto num_slack = num_calls;
+    CHECK(info.num_iters == num_slack + 1); // counts one extra, as bsearch
+
+    num_calls = 0U;
+    auto I2 = std::make_pair(0., 100.);
+    bsearch(Omega_bool, I2);
+    CHECK(num_slack < num_calls / 2); // far fewer probes
+}
@@ -6,9 +6,14 @@
 #include <ellcpp/ell.hpp>
 #include <ellcpp/ell_stable.hpp>
 #include <ellcpp/oracles/lmi_old_oracle.hpp>
+#include <ellcpp/oracles/sparse_lmi_old_oracle.hpp>
 #include <gsl/span>
 #include <vector>
 #include <xtensor-blas/xlinalg.hpp>
+#include <xtensor/xview.hpp>
+
+namespace
+{ // not to clash with my_oracle of lmi_test.cpp
 
 /*!
  * @brief my_oracle
@@ -75,6 +80,8 @@ class my_oracle
     }
 };
 
+} // namespace
+
 TEST_CASE("LMI (old) test")
 {
     using Arr = xt::xarray<double, xt::layout_type::row_major>;
@@ -121,3 +128,58 @@ TEST_CASE("LMI (old) test (stable)")
     CHECK(ell_info.feasible);
     CHECK(ell_info.num_iters == 112);
 }
+
+TEST_CASE("LMI (old) test (sparse)")
+{
+    using Arr = xt::xarray<double, xt::layout_type::row_major>;
+    using M_t = std::vector<Arr>;
+
+    const auto F2 = M_t {{{-21., -11., 0.}, {-11., 10., 8.}, {0., 8., 5.}},
+        {{0., 10., 16.}, {10., -10., -10.}, {16., -10., 3.}},
+        {{-5., 2., -17.}, {2., -6., 8.}, {-17., 8., 6.}}};
+    const auto B2 = Arr {{14., 9., 40.}, {9., 91., 10.}, {40., 10., 15.}};
+
+    // the nonzeros of the lower triangles
+    auto F2_coo = std::vector<coo_matrix>(F2.size());
+    for (auto k = 0U; k != F2.size(); ++k)
+    {
+        for (auto i = 0U; i != 3U; ++i)
+        {
+            for (auto j = 0U; j <= i; ++j)
+            {
+                if (F2[k](i, j) != 0.)
+                {
+                    F2_coo[k].row.push_back(i);
+                    F2_coo[k].col.push_back(j);
+                    F2_coo[k].val.push_back(F2[k](i, j));
+                }
+            }
+        }
+    }
+
+    auto P = lmi_old_oracle {F2, B2};
+    auto Q = sparse_lmi_old_oracle {F2_coo, B2};
+    const auto X = Arr {{0., 0., 0.}, {1., -1., 1.}, {-2., 0.5, 3.},
+        {5., 5., 5.}};
+    auto num_cuts = 0U;
+    for (auto p = 0U; p != X.shape()[0]; ++p)
+    {
+        const auto x = Arr {xt::view(X, p, xt::all())};
+        const auto cut = P(x);
+        const auto sparse_cut = Q(x);
+        REQUIRE(bool(cut) == bool(sparse_cut));
+        if (!cut)
+        {
+            continue;
+        }
+        ++num_cuts;
+        const auto& [g, ep] = *cut;
+        const auto& [sg, sep] = *sparse_cut;
+        CHECK(sep == doctest::Approx(ep));
+        for (auto k = 0U; k != g.size(); ++k)
+        {
+            CHECK(sg(k) == doctest::Approx(g(k)));
+        }
+    }
+    CHECK(num_cuts > 0);
+}
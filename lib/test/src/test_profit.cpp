@@ -1,15 +1,27 @@
 /*
  *  Distributed under the MIT License (See accompanying file /LICENSE )
  */
+#include <cmath>
 #include <doctest/doctest.h>
 #include <ellcpp/cutting_plane.hpp>
 #include <ellcpp/ell.hpp>
 #include <ellcpp/ell_stable.hpp>
 #include <ellcpp/oracles/profit_oracle.hpp>
+#include <limits>
+#include <tuple>
 #include <xtensor/xarray.hpp>
 
 // using namespace fun;
 
+using Vec = xt::xarray<double, xt::layout_type::row_major>;
+
+// the profit maximization problem of the tests
+static const auto p = 20.;
+static const auto A = 40.;
+static const auto k = 30.5;
+static const auto a = Vec {0.1, 0.4};
+static const auto v = Vec {10., 35.};
+
 TEST_CASE("Profit Test")
 {
     using Vec = xt::xarray<double, xt::layout_type::row_major>;
@@ -87,3 +99,220 @@ TEST_CASE("Profit Test (Stable)")
         CHECK(ell_info.num_iters == 30);
     }
 }
+
+TEST_CASE("Profit Test (deadline and cancellation)")
+{
+    {
+        auto E = ell {100., Vec {0., 0.}};
+        auto P = profit_oracle {p, A, k, a, v};
+        auto options = Options();
+        options.deadline = std::chrono::steady_clock::now()
+            + std::chrono::hours(1);
+        const auto [y, ell_info] = cutting_plane_dc(P, E, 0., options);
+        CHECK(ell_info.status == CUTStatus::smallenough);
+        CHECK(ell_info.num_iters == 37);
+        CHECK(ell_info.tsq < options.tol);
+    }
+
+    {
+        auto E = ell {100., Vec {0., 0.}};
+        auto P = profit_oracle {p, A, k, a, v};
+        auto options = Options();
+        options.deadline = std::chrono::steady_clock::now();
+        const auto [y, ell_info] = cutting_plane_dc(P, E, 0., options);
+        CHECK(ell_info.status == CUTStatus::timeout);
+        CHECK(!ell_info.feasible);
+    }
+
+    {
+        auto E = ell {100., Vec {2., 0.}};
+        auto P = profit_q_oracle {p, A, k, a, v};
+        auto cancel = std::atomic<bool> {true};
+        auto options = Options();
+        options.cancel = &cancel;
+        const auto [y, ell_info] = cutting_plane_q(P, E, 0., options);
+        CHECK(ell_info.status == CUTStatus::timeout);
+        CHECK(ell_info.num_iters == 1);
+    }
+}
+
+TEST_CASE("Profit Test (memoized discrete points)")
+{
+    auto E = ell {100., Vec {2., 0.}};
+    auto P = profit_q_oracle {p, A, k, a, v};
+    auto options = Options();
+    options.memoize = true;
+    const auto [y, ell_info] = cutting_plane_q(P, E, 0., options);
+    CHECK(y[0] <= std::log(k));
+    CHECK(ell_info.num_iters == 28);
+
+    // counts the assessments that reach profit_q_oracle
+    struct counted_q_oracle
+    {
+        profit_q_oracle P;
+        unsigned int num_calls = 0;
+
+        auto discretize(const Vec& y) -> const Vec&
+        {
+            return this->P.discretize(y);
+        }
+
+        auto operator()(const Vec& y, double& t, bool retry)
+        {
+            ++this->num_calls;
+            return this->P(y, t, retry);
+        }
+    };
+
+    // a tighter k, where discrete points come up again for the same t
+    const auto k2 = 2.5;
+    auto E1 = ell {100., Vec {2., 0.}};
+    auto P1 = counted_q_oracle {profit_q_oracle {p, A, k2, a, v}};
+    const auto [y1, info1] = cutting_plane_q(P1, E1, 0.);
+
+    auto E2 = ell {100., Vec {2., 0.}};
+    auto P2 = counted_q_oracle {profit_q_oracle {p, A, k2, a, v}};
+    const auto [y2, info2] = cutting_plane_q(P2, E2, 0., options);
+    CHECK(info2.num_iters == info1.num_iters);
+    CHECK(y2[0] == y1[0]);
+    CHECK(P2.num_calls < P1.num_calls);
+}
+
+TEST_CASE("cutting_plane_q (memoized discrete points)")
+{
+    using Cut = std::tuple<Vec, double>;
+
+    // min ||x - c||^2 over integer points
+    struct quad_q_oracle
+    {
+        Vec c {7.3, 2.4};
+        Vec xd;
+        unsigned int num_calls = 0;
+
+        auto discretize(const Vec& x) -> const Vec&
+        {
+            this->xd = xt::round(x);
+            return this->xd;
+        }
+
+        auto operator()(const Vec& x, double& t, bool retry)
+            -> std::tuple<Cut, Vec, bool, bool>
+        {
+            ++this->num_calls;
+            if (!retry)
+            {
+                this->discretize(x);
+            }
+            const auto d = Vec {this->xd - this->c};
+            const auto f = d[0] * d[0] + d[1] * d[1];
+            auto g = Vec {2. * d};
+            auto beta = g[0] * (this->xd[0] - x[0])
+                + g[1] * (this->xd[1] - x[1]);
+            auto shrunk = false;
+            if (f < t)
+            {
+                t = f;
+                shrunk = true;
+            }
+            else
+            {
+                beta += f - t;
+            }
+            return {{std::move(g), beta}, this->xd, shrunk, !retry};
+        }
+    };
+
+    auto E1 = ell {100., Vec {0., 0.}};
+    auto Q1 = quad_q_oracle {};
+    auto t1 = 100.;
+    const auto [x1, info1] = cutting_plane_q(Q1, E1, t1);
+
+    auto E2 = ell {100., Vec {0., 0.}};
+    auto Q2 = quad_q_oracle {};
+    auto t2 = 100.;
+    auto options = Options();
+    options.memoize = true;
+    const auto [x2, info2] = cutting_plane_q(Q2, E2, t2, options);
+
+    CHECK(info2.num_iters == info1.num_iters);
+    CHECK(t2 == t1);
+    CHECK(x2[0] == 7.);
+    CHECK(x2[1] == 2.);
+    CHECK(Q2.num_calls < Q1.num_calls);
+}
+
+TEST_CASE("Profit Test (box constraints)")
+{
+    const auto inf = std::numeric_limits<double>::infinity();
+
+    auto num_calls = 0U;
+    auto P = profit_oracle {p, A, k, a, v};
+    auto Omega = [&](const Vec& y, double& t) {
+        ++num_calls;
+        return P(y, t);
+    };
+
+    auto E1 = ell {100., Vec {0., 0.}};
+    auto t1 = 0.;
+    const auto [y1, info1] = cutting_plane_dc(Omega, E1, t1);
+    const auto num_calls1 = num_calls;
+
+    num_calls = 0U;
+    auto E2 = ell {100., Vec {0., 0.}};
+    E2.set_bounds(Vec {-inf, -inf}, Vec {std::log(k), inf});
+    auto t2 = 0.;
+    const auto [y2, info2] = cutting_plane_dc(Omega, E2, t2);
+    CHECK(y2[0] <= std::log(k));
+    CHECK(t2 == doctest::Approx(t1).epsilon(1e-6));
+    CHECK(num_calls < num_calls1);
+
+    num_calls = 0U;
+    auto E3 = ell_stable {100., Vec {0., 0.}};
+    E3.set_bounds(Vec {-inf, -inf}, Vec {std::log(k), inf});
+    auto t3 = 0.;
+    const auto [y3, info3] = cutting_plane_dc(Omega, E3, t3);
+    CHECK(y3[0] <= std::log(k));
+    CHECK(t3 == doctest::Approx(t1).epsilon(1e-4));
+}
+
+TEST_CASE("Profit Test (cut buffer)")
+{
+    const auto P = profit_oracle {p, A, k, a, v};
+
+    // the buffer form gives the same cuts as the legacy one
+    auto cut = profit_oracle::cut_t {};
+    for (const auto& y : {Vec {4., 1.}, Vec {1., 2.}, Vec {2., 0.5}})
+    {
+        auto t0 = 0.;
+        auto t1 = 0.;
+        const auto [cut0, shrunk0] = P(y, t0);
+        const auto shrunk1 = P(y, t1, cut);
+        CHECK(shrunk0 == shrunk1);
+        CHECK(t0 == t1);
+        CHECK(std::get<1>(cut0) == doctest::Approx(std::get<1>(cut)));
+        CHECK(std::get<0>(cut0)[0] == doctest::Approx(std::get<0>(cut)[0]));
+        CHECK(std::get<0>(cut0)[1] == doctest::Approx(std::get<0>(cut)[1]));
+    }
+
+    // the driver holds the buffer: same iterations as before
+    auto E = ell {100., Vec {0., 0.}};
+    const auto [y, ell_info] = cutting_plane_dc(P, std::move(E), 0.);
+    CHECK(y[0] <= std::log(k));
+    CHECK(ell_info.num_iters == 37);
+}
+
+TEST_CASE("Profit Test (no optimality gap)")
+{
+    const auto P = profit_oracle {p, A, k, a, v};
+
+    // t is maximized through a log-transformed cut: f(xc) - sqrt(tsq) is
+    // no bound here, so the gap must not be certified, nor end the run
+    auto options = Options();
+    options.gap_rtol = 0.1;
+    auto E = ell {100., Vec {0., 0.}};
+    auto t = 0.;
+    const auto [y, ell_info] = cutting_plane_dc(P, std::move(E), t, options);
+    CHECK(y[0] <= std::log(k));
+    CHECK(std::isinf(ell_info.gap));
+    CHECK(ell_info.num_iters == 37);
+}